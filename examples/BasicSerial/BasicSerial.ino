@@ -3,7 +3,10 @@
  * @brief Minimal Device-Defined-Dashboard example.
  *
  * Simulates an environment sensor (temperature, humidity, pressure, light)
- * and streams Serial Studio dashboard frames over USB-CDC serial at 1 Hz.
+ * and streams Serial Studio dashboard frames over USB-CDC serial.  The frame
+ * rate starts at 1 Hz and then adapts to the measured link throughput.
+ * Sensors are sampled every 50 ms so a temperature alarm transition is sent
+ * immediately rather than on the next 1 s frame.
  *
  * No WiFi required — connect Serial Studio directly to the COM / tty port.
  *
@@ -20,23 +23,26 @@
 #include <ArduinoJson.h>
 #include "ss_dashboard.h"
 #include "ss_dashboard_config.h"
+#include "ss_transport.h"
+#include "ss_project_writer.h"
 
 // ─── Dashboard configuration ──────────────────────────────────────────────────
 
-static const ss::ActionCfg kActions[] = {
+static constexpr ss::ActionCfg kActions[] = {
     { .title = "Reset",     .txData = "reset",  .icon = "Done"  },
     { .title = "Calibrate", .txData = "cal",    .icon = "Settings" },
 };
 
-static const ss::DatasetCfg kEnvDatasets[] = {
+static constexpr ss::DatasetCfg kEnvDatasets[] = {
     { .title = "Temperature", .units = "°C",
       .telemetryKey = "temp",
       .index = 1,
       .widget = ss::WidgetType::Gauge,
       .widgetMin = -20.0f, .widgetMax = 80.0f,
       .plotMin   = -20.0f, .plotMax   = 80.0f,
-      .alarmEnabled = true, .alarmHigh = 40.0f, .alarmLow = -10.0f,
-      .graph = true, .log = true, .overviewDisplay = true },
+      .alarmLow = -10.0f, .alarmHigh = 40.0f, .alarmEnabled = true,
+      .graph = true, .log = true, .overviewDisplay = true,
+      .alarmHysteresis = 1.0f, .alarmImmediate = true },
 
     { .title = "Humidity", .units = "%RH",
       .telemetryKey = "humidity",
@@ -53,7 +59,7 @@ static const ss::DatasetCfg kEnvDatasets[] = {
       .graph = true, .log = true },
 };
 
-static const ss::DatasetCfg kSysDatasets[] = {
+static constexpr ss::DatasetCfg kSysDatasets[] = {
     { .title = "Light", .units = "lux",
       .telemetryKey = "light",
       .index = 4,
@@ -67,7 +73,7 @@ static const ss::DatasetCfg kSysDatasets[] = {
       .graph = true },
 };
 
-static const ss::GroupCfg kGroups[] = {
+static constexpr ss::GroupCfg kGroups[] = {
     { .title = "Environment",
       .widget = ss::GroupWidget::Multiplot,
       .datasets     = kEnvDatasets,
@@ -79,7 +85,7 @@ static const ss::GroupCfg kGroups[] = {
       .datasetCount = sizeof(kSysDatasets) / sizeof(kSysDatasets[0]) },
 };
 
-static const ss::DashboardCfg kDashboardCfg = {
+static constexpr ss::DashboardCfg kDashboardCfg = {
     .title      = "Environment Monitor",
     .groups     = kGroups,
     .groupCount = sizeof(kGroups) / sizeof(kGroups[0]),
@@ -90,10 +96,24 @@ static const ss::DashboardCfg kDashboardCfg = {
 // ─── Module globals ───────────────────────────────────────────────────────────
 
 static ss::Dashboard  dashboard(kDashboardCfg);
-static char           txBuf[8192];
 
-static uint32_t lastEmitMs = 0;
-static constexpr uint32_t kEmitIntervalMs = 1000;
+// Sized at compile time for the widest value every dataset can hold, so
+// serialize() cannot run out of room.
+static char           txBuf[ss::StaticProject<kDashboardCfg>::kMaxFrameSize];
+
+static uint32_t lastEmitMs   = 0;
+static uint32_t lastSampleMs = 0;
+static constexpr uint32_t kEmitIntervalMs   = 1000;   // until the link is measured
+static constexpr uint32_t kSampleIntervalMs = 50;
+
+// Picks the emit interval from the measured drain time of each frame, so
+// the same sketch holds ~70 % link load at 115200 baud or over native USB.
+static const ss::RateControllerCfg kRateCfg = {
+    .minIntervalMs = 100,
+    .maxIntervalMs = 5000,
+    .targetUtilPct = 70,
+};
+static ss::RateController rate(kRateCfg, kEmitIntervalMs);
 
 // ─── Simulated sensor readings ────────────────────────────────────────────────
 
@@ -111,30 +131,42 @@ void setup() {
     Serial.println("[app] Environment Monitor starting");
 
     dashboard.begin();
-    Serial.printf("[app] Dashboard frame size: ~%u bytes\n",
-                  static_cast<unsigned>(dashboard.estimateSize()));
+    Serial.printf("[app] Dashboard frame size: %u bytes (buffer %u)\n",
+                  static_cast<unsigned>(dashboard.estimateSize()),
+                  static_cast<unsigned>(sizeof(txBuf)));
 }
 
 // ─── Loop ─────────────────────────────────────────────────────────────────────
 
 void loop() {
     const uint32_t now = millis();
-    if (now - lastEmitMs < kEmitIntervalMs) return;
-    lastEmitMs = now;
+    if (now - lastSampleMs < kSampleIntervalMs) return;
+    lastSampleMs = now;
 
-    // Build flat telemetry document.
-    JsonDocument telemetry;
+    // Build flat telemetry document.  The Dashboard's pooled document keeps
+    // its memory between ticks, so this allocates nothing after the first.
+    JsonDocument& telemetry = dashboard.beginTelemetry();
     telemetry["temp"]     = simulateTemp();
     telemetry["humidity"] = simulateHumidity();
     telemetry["pressure"] = simulatePressure();
     telemetry["light"]    = simulateLight();
     telemetry["uptime"]   = now / 1000UL;
 
-    // Patch dashboard values and serialise.
+    // Patch dashboard values.  This also evaluates the temperature alarm.
     dashboard.update(telemetry);
+
+    // Emit on the regular cadence, or straight away on an alarm transition.
+    if (now - lastEmitMs < rate.intervalMs() && !dashboard.priorityFramePending()) {
+        return;
+    }
+    lastEmitMs = now;
+
     const size_t len = dashboard.serialize(txBuf, sizeof(txBuf));
     if (len > 0) {
+        const uint32_t t0 = micros();
         Serial.write(txBuf, len);
+        Serial.flush();                       // wait for the UART to drain
+        rate.recordFrame(len, micros() - t0);
     } else {
         Serial.println("[app] serialize() failed — buffer too small?");
     }
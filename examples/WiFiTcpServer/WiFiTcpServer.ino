@@ -18,7 +18,10 @@
  * Serial Studio setup:
  *   1. Open Serial Studio → File → Connect → Network → TCP Client
  *   2. Host: <board IP printed on Serial>, Port: 8080
- *   3. The dashboard will appear automatically once connected.
+ *   3. The dashboard will appear automatically once connected.  Each
+ *      client gets the full project once, then compact data rows until
+ *      the layout changes, also across reconnects.  Send "project" to
+ *      get the project again.
  *   4. Use the action buttons to send commands back to the device.
  *
  * Dependencies:
@@ -42,6 +45,8 @@
 #include <freertos/task.h>
 #include "ss_dashboard.h"
 #include "ss_dashboard_config.h"
+#include "ss_transport.h"
+#include "ss_project_writer.h"
 
 // ─── Credentials — change before flashing ────────────────────────────────────
 
@@ -51,20 +56,20 @@ static constexpr uint16_t kPort   = 8080;
 
 // ─── Dashboard configuration ──────────────────────────────────────────────────
 
-static const ss::ActionCfg kActions[] = {
+static constexpr ss::ActionCfg kActions[] = {
     { .title = "Start",  .txData = "start",  .icon = "Done"     },
     { .title = "Stop",   .txData = "stop",   .icon = "Close"    },
     { .title = "Status", .txData = "status", .icon = "System Task" },
 };
 
-static const ss::DatasetCfg kEnvDatasets[] = {
+static constexpr ss::DatasetCfg kEnvDatasets[] = {
     { .title = "Temperature", .units = "°C",
       .telemetryKey = "temp",
       .index = 1,
       .widget = ss::WidgetType::Gauge,
       .widgetMin = -20.0f, .widgetMax = 80.0f,
       .plotMin   = -20.0f, .plotMax   = 80.0f,
-      .alarmEnabled = true, .alarmHigh = 50.0f,
+      .alarmHigh = 50.0f, .alarmEnabled = true,
       .graph = true, .log = true, .overviewDisplay = true },
 
     { .title = "Humidity", .units = "%RH",
@@ -82,7 +87,7 @@ static const ss::DatasetCfg kEnvDatasets[] = {
       .graph = true, .log = true },
 };
 
-static const ss::DatasetCfg kImuDatasets[] = {
+static constexpr ss::DatasetCfg kImuDatasets[] = {
     { .title = "Accel X", .units = "m/s²",
       .telemetryKey = "imu.ax",
       .index = 4, .graph = true },
@@ -97,17 +102,20 @@ static const ss::DatasetCfg kImuDatasets[] = {
       .graph = true },
 };
 
-static const ss::DatasetCfg kSysDatasets[] = {
+static constexpr ss::DatasetCfg kSysDatasets[] = {
+    // Housekeeping: refreshed round-robin, one per frame, at most 1 Hz.
     { .title = "Uptime", .units = "s",
       .telemetryKey = "uptime",
-      .index = 7, .graph = true },
+      .index = 7, .graph = true,
+      .priority = ss::Priority::Housekeeping, .maxRateHz = 1 },
 
     { .title = "Free Heap", .units = "bytes",
       .telemetryKey = "heap",
-      .index = 8, .graph = true },
+      .index = 8, .graph = true,
+      .priority = ss::Priority::Housekeeping, .maxRateHz = 1 },
 };
 
-static const ss::GroupCfg kGroups[] = {
+static constexpr ss::GroupCfg kGroups[] = {
     { .title = "Environment",
       .widget = ss::GroupWidget::Multiplot,
       .datasets     = kEnvDatasets,
@@ -124,7 +132,7 @@ static const ss::GroupCfg kGroups[] = {
       .datasetCount = sizeof(kSysDatasets) / sizeof(kSysDatasets[0]) },
 };
 
-static const ss::DashboardCfg kDashboardCfg = {
+static constexpr ss::DashboardCfg kDashboardCfg = {
     .title      = "ESP32 Monitor",
     .groups     = kGroups,
     .groupCount = sizeof(kGroups) / sizeof(kGroups[0]),
@@ -138,17 +146,40 @@ static constexpr uint8_t kMaxClients = 4;
 
 static AsyncServer  tcpServer(kPort);
 static AsyncClient* clients[kMaxClients] = {};
+// Handshake identity.  The IPv4 address is good enough on a LAN where each
+// dashboard has its own; clients behind one NAT would share an entry, and
+// one could be marked served without the project.  There, have clients
+// announce an id through onClientData() and key the handshake on that.
+static uint32_t     clientIds[kMaxClients] = {};
 static ss::Dashboard dashboard(kDashboardCfg);
 
-// Transmit buffer — large enough for the full JSON frame.
-static constexpr size_t kTxBufSize = 16384;
+// Remembers which layout each client last received, so the project is sent
+// once per layout and data rows follow, even after a reconnect.
+static ss::ProjectHandshake handshake(ss::HandshakeCfg{});
+
+// Small frames are packed into one TCP segment before they reach lwIP; the
+// coalescer does the batching with a bounded deadline, so Nagle is switched
+// off on every client socket.
+static const ss::CoalescerCfg kCoalesceCfg = {
+    .mtu             = 1460,
+    .flushDeadlineMs = 5,
+    .noDelay         = true,
+};
+
+// Transmit buffer — sized at compile time for the full JSON frame with every
+// dataset at its widest value, so serialize() cannot run out of room.
+static constexpr size_t kTxBufSize = ss::StaticProject<kDashboardCfg>::kMaxFrameSize;
 static char txBuf[kTxBufSize];
 
+// Data-row buffer for clients that already hold the project.
+static constexpr size_t kRowBufSize = ss::StaticProject<kDashboardCfg>::kMaxRowSize;
+static char rowBuf[kRowBufSize];
+
 // ─── Client management ────────────────────────────────────────────────────────
 
 static void removeClient(AsyncClient* c) {
-    for (auto& slot : clients) {
-        if (slot == c) { slot = nullptr; return; }
+    for (uint8_t i = 0; i < kMaxClients; ++i) {
+        if (clients[i] == c) { clients[i] = nullptr; return; }
     }
 }
 
@@ -181,17 +212,24 @@ static void onClientData(void* /*arg*/, AsyncClient* c, void* data, size_t len)
     if (end > 0) {
         Serial.printf("[tcp] Client %s cmd: %s\n",
                       c->remoteIP().toString().c_str(), buf);
-        // Handle the command here (or dispatch to your command handler).
+        // A client that lost its project (e.g. a fresh Serial Studio
+        // session) asks for it again; it goes out with the next frame.
+        if (strcmp(buf, "project") == 0) {
+            handshake.forget(static_cast<uint32_t>(c->remoteIP()));
+        }
+        // Handle other commands here (or dispatch to your command handler).
     }
 }
 
 static void onNewClient(void* /*arg*/, AsyncClient* c) {
-    for (auto& slot : clients) {
-        if (!slot) {
-            slot = c;
+    for (uint8_t i = 0; i < kMaxClients; ++i) {
+        if (!clients[i]) {
+            clientIds[i] = static_cast<uint32_t>(c->remoteIP());
+            clients[i]   = c;
             c->onDisconnect(&onClientDisconnect, nullptr);
             c->onError(&onClientError, nullptr);
             c->onData(&onClientData, nullptr);
+            c->setNoDelay(kCoalesceCfg.noDelay);
             Serial.printf("[tcp] Client %s connected\n",
                           c->remoteIP().toString().c_str());
             return;
@@ -236,29 +274,94 @@ static void sendChunked(AsyncClient* c, const char* data, size_t len) {
     }
 }
 
+// ─── Adaptive frame rate ──────────────────────────────────────────────────────
+
+static constexpr uint32_t kBroadcastMs = 1000;   // until the link is measured
+
+// Adjusts the broadcast interval to the measured send time of each segment.
+static const ss::RateControllerCfg kRateCfg = {
+    .minIntervalMs = 50,
+    .maxIntervalMs = 5000,
+    .targetUtilPct = 60,
+};
+static ss::RateController rate(kRateCfg, kBroadcastMs);
+
+// ─── Segment coalescing ───────────────────────────────────────────────────────
+
+/**
+ * Coalescer sink: send one segment (at most one MTU) to the client whose
+ * slot in links[] is @p ctx.  Frames larger than the MTU, like the full
+ * project JSON, arrive here one MTU-sized piece at a time.  The sends are
+ * what occupies the link, so they are what the rate controller measures.
+ * Bytes for a client that has gone are dropped.
+ */
+static size_t sendSegment(void* ctx, const char* data, size_t len) {
+    AsyncClient* c = *static_cast<AsyncClient**>(ctx);
+    if (!c || !c->connected()) return len;
+
+    const uint32_t t0 = micros();
+    sendChunked(c, data, len);
+    rate.recordWrite(len, micros() - t0);
+    return len;
+}
+
+// The client each coalescer is currently sending to.  Only the dashboard
+// task touches links[] and coalescers[]; it latches clients[] into links[]
+// before each poll, so a segment queued for one client never reaches the
+// next one to take the slot.
+static AsyncClient* links[kMaxClients] = {};
+
+// One coalescer per client slot: clients are sent different frames (project
+// or data rows), so their segments cannot be shared.
+static_assert(kMaxClients == 4, "one coalescer per client slot");
+static ss::FrameCoalescer coalescers[kMaxClients] = {
+    { kCoalesceCfg, &sendSegment, &links[0] },
+    { kCoalesceCfg, &sendSegment, &links[1] },
+    { kCoalesceCfg, &sendSegment, &links[2] },
+    { kCoalesceCfg, &sendSegment, &links[3] },
+};
+
 // ─── Dashboard FreeRTOS task ──────────────────────────────────────────────────
 
 // NOTE: on ESP-IDF, the usStackDepth parameter to xTaskCreatePinnedToCore
 // is in BYTES (unlike vanilla FreeRTOS where it is in words).
 static constexpr uint32_t    kTaskStackBytes = 8192;
 static constexpr UBaseType_t kTaskPriority   = 1;
-static constexpr uint32_t    kBroadcastMs    = 1000;
 
 static void dashboardTask(void* /*arg*/) {
-    TickType_t lastWake = xTaskGetTickCount();
+    TickType_t lastWake      = xTaskGetTickCount();
+    uint32_t   lastBroadcast = 0;
+    uint32_t   lastReport    = 0;
 
     for (;;) {
-        vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(kBroadcastMs));
+        // Wake at the coalescing deadline so a lone small frame is never
+        // held back longer than flushDeadlineMs.
+        vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(kCoalesceCfg.flushDeadlineMs));
+        for (uint8_t i = 0; i < kMaxClients; ++i) {
+            // A slot that changed hands drops what was left for the old
+            // client, partial frame included.
+            if (links[i] != clients[i]) {
+                coalescers[i].reset();
+                links[i] = clients[i];
+            }
+            coalescers[i].poll(millis());
+        }
+
+        if (millis() - lastBroadcast < rate.intervalMs()) continue;
+        lastBroadcast = millis();
 
         // Check for at least one connected client.
         bool anyConnected = false;
-        for (const auto* c : clients) {
+        for (const auto* c : links) {
             if (c && c->connected()) { anyConnected = true; break; }
         }
         if (!anyConnected) continue;
 
-        // Build telemetry document.  Replace with real sensor reads.
-        JsonDocument telemetry;
+        // Pick the slots refreshed this frame, then build the telemetry
+        // document (pooled, so no heap traffic per frame).  Replace with
+        // real sensor reads.
+        dashboard.beginFrame(millis());
+        JsonDocument& telemetry = dashboard.beginTelemetry();
         telemetry["temp"]     = 20.0f + 5.0f * sinf(millis() / 8000.0f);
         telemetry["humidity"] = 55.0f;
         telemetry["pressure"] = 1013.0f;
@@ -269,15 +372,54 @@ static void dashboardTask(void* /*arg*/) {
         telemetry["heap"]     = static_cast<uint32_t>(ESP.getFreeHeap());
 
         dashboard.update(telemetry);
-        const size_t len = dashboard.serialize(txBuf, kTxBufSize);
-        if (len == 0) {
-            Serial.println("[dashboard] serialize() failed");
-            continue;
-        }
 
-        for (auto* c : clients) {
+        // Clients that lack the current layout get the project; the rest
+        // get a data row.  Each frame is built at most once per tick.
+        const uint32_t hash     = dashboard.layoutHash();
+        size_t         frameLen = 0;
+        size_t         rowLen   = 0;
+        bool           rowBuilt = false;
+        size_t         total    = 0;
+
+        for (uint8_t i = 0; i < kMaxClients; ++i) {
+            AsyncClient* c = links[i];
             if (!c || !c->connected()) continue;
-            sendChunked(c, txBuf, len);
+
+            const char* out = rowBuf;
+            size_t      len = 0;
+            if (handshake.needsProject(clientIds[i], hash, millis())) {
+                if (frameLen == 0) frameLen = dashboard.serialize(txBuf, kTxBufSize);
+                if (frameLen == 0) {
+                    Serial.println("[dashboard] serialize() failed");
+                    continue;
+                }
+                out = txBuf;
+                len = frameLen;
+                handshake.projectSent(clientIds[i], hash, millis());
+            } else {
+                if (!rowBuilt) {
+                    rowLen   = dashboard.serializeData(rowBuf, kRowBufSize);
+                    rowBuilt = true;
+                }
+                len = rowLen;   // 0 when no dataset was due this tick
+            }
+
+            for (size_t sent = 0; sent < len;) {
+                sent += coalescers[i].push(out + sent, len - sent, millis());
+            }
+            total += len;
+        }
+
+        // push() only copies into the segment buffer; the link time is
+        // measured by sendSegment(), so only the size is reported here.
+        if (total) rate.recordFrame(total);
+
+        if (millis() - lastReport >= 10000) {
+            lastReport = millis();
+            Serial.printf("[dashboard] %.1f fps, %u B/s, link %u%%\n",
+                          rate.framesPerSecond(),
+                          static_cast<unsigned>(rate.throughputBps()),
+                          static_cast<unsigned>(rate.utilisationPct()));
         }
     }
 }
@@ -307,8 +449,9 @@ void setup() {
     connectWifi();
 
     dashboard.begin();
-    Serial.printf("[dashboard] Frame size: ~%u bytes\n",
-                  static_cast<unsigned>(dashboard.estimateSize()));
+    Serial.printf("[dashboard] Frame size: %u bytes (buffer %u)\n",
+                  static_cast<unsigned>(dashboard.estimateSize()),
+                  static_cast<unsigned>(kTxBufSize));
 
     tcpServer.onClient(&onNewClient, nullptr);
     tcpServer.begin();
@@ -0,0 +1,128 @@
+/**
+ * @file ss_checksum.cpp
+ * @brief Table-driven frame checksums — implementation.
+ */
+
+#include "ss_checksum.h"
+
+namespace ss {
+
+// ─── Compile-time tables ─────────────────────────────────────────────────────
+
+namespace {
+
+template <typename T, size_t N>
+struct Table {
+    T v[N];
+};
+
+// MSB-first table for an 8- or 16-bit polynomial.
+template <typename T, int Bits>
+constexpr Table<T, 256> makeMsbTable(T poly) {
+    Table<T, 256> t{};
+    for (unsigned i = 0; i < 256; ++i) {
+        T crc = static_cast<T>(i << (Bits - 8));
+        for (int b = 0; b < 8; ++b) {
+            const bool top = (crc >> (Bits - 1)) & 1u;
+            crc = static_cast<T>(crc << 1);
+            if (top) crc = static_cast<T>(crc ^ poly);
+        }
+        t.v[i] = crc;
+    }
+    return t;
+}
+
+constexpr Table<uint32_t, 256> makeCrc32Table() {
+    Table<uint32_t, 256> t{};
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t crc = i;
+        for (int b = 0; b < 8; ++b) crc = (crc >> 1) ^ ((crc & 1u) ? 0xEDB88320u : 0u);
+        t.v[i] = crc;
+    }
+    return t;
+}
+
+constexpr auto kCrc8  = makeMsbTable<uint8_t, 8>(0x07);
+constexpr auto kCrc16 = makeMsbTable<uint16_t, 16>(0x1021);
+constexpr auto kCrc32 = makeCrc32Table();
+
+#if SS_CRC32_SLICE_BY_8
+// kSlice.v[k][i] advances the CRC of byte i by k further zero bytes.
+constexpr Table<Table<uint32_t, 256>, 8> makeSlice8() {
+    Table<Table<uint32_t, 256>, 8> t{};
+    t.v[0] = kCrc32;
+    for (int k = 1; k < 8; ++k) {
+        for (int i = 0; i < 256; ++i) {
+            const uint32_t prev = t.v[k - 1].v[i];
+            t.v[k].v[i] = (prev >> 8) ^ kCrc32.v[prev & 0xFFu];
+        }
+    }
+    return t;
+}
+
+constexpr auto kSlice = makeSlice8();
+#endif
+
+} // namespace
+
+// ─── FrameCrc ────────────────────────────────────────────────────────────────
+
+FrameCrc::FrameCrc(Checksum algo)
+    : algo_(algo),
+      crc_(algo == Checksum::Crc16 ? 0xFFFFu :
+           algo == Checksum::Crc32 ? 0xFFFFFFFFu : 0u)
+{}
+
+void FrameCrc::update(const void* data, size_t len) {
+    const auto* p = static_cast<const uint8_t*>(data);
+
+    switch (algo_) {
+        case Checksum::Crc8: {
+            uint8_t crc = static_cast<uint8_t>(crc_);
+            while (len--) crc = kCrc8.v[crc ^ *p++];
+            crc_ = crc;
+            break;
+        }
+        case Checksum::Crc16: {
+            uint16_t crc = static_cast<uint16_t>(crc_);
+            while (len--) crc = static_cast<uint16_t>((crc << 8) ^ kCrc16.v[(crc >> 8) ^ *p++]);
+            crc_ = crc;
+            break;
+        }
+        case Checksum::Crc32: {
+            uint32_t crc = crc_;
+#if SS_CRC32_SLICE_BY_8
+            while (len >= 8) {
+                const uint32_t lo = crc ^ (p[0] | (p[1] << 8) | (p[2] << 16) |
+                                           (static_cast<uint32_t>(p[3]) << 24));
+                crc = kSlice.v[7].v[lo & 0xFFu]         ^ kSlice.v[6].v[(lo >> 8) & 0xFFu] ^
+                      kSlice.v[5].v[(lo >> 16) & 0xFFu] ^ kSlice.v[4].v[lo >> 24]          ^
+                      kSlice.v[3].v[p[4]]               ^ kSlice.v[2].v[p[5]]              ^
+                      kSlice.v[1].v[p[6]]               ^ kSlice.v[0].v[p[7]];
+                p   += 8;
+                len -= 8;
+            }
+#endif
+            while (len--) crc = (crc >> 8) ^ kCrc32.v[(crc ^ *p++) & 0xFFu];
+            crc_ = crc;
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+uint32_t FrameCrc::value() const {
+    return algo_ == Checksum::Crc32 ? crc_ ^ 0xFFFFFFFFu : crc_;
+}
+
+size_t FrameCrc::write(char* out) const {
+    const uint8_t  n = checksumSize(algo_);
+    const uint32_t v = value();
+    for (uint8_t i = 0; i < n; ++i) {
+        out[i] = static_cast<char>((v >> (8 * (n - 1 - i))) & 0xFFu);
+    }
+    return n;
+}
+
+} // namespace ss
@@ -0,0 +1,77 @@
+/**
+ * @file ss_checksum.h
+ * @brief Table-driven frame checksums matching Serial Studio's options.
+ *
+ * Serial Studio validates a frame by reading a binary checksum that follows
+ * the end delimiter and comparing it with one computed over the frame
+ * payload (the bytes between the delimiters).  FrameCrc computes that value
+ * incrementally, so the Dashboard can fold each chunk in as it writes it.
+ *
+ * All kernels are byte-at-a-time with a 256-entry table generated at compile
+ * time and stored in flash.  Define SS_CRC32_SLICE_BY_8=1 to switch CRC-32
+ * to slice-by-8 (eight bytes per step, 8 KB of tables instead of 1 KB).
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#ifndef SS_CRC32_SLICE_BY_8
+#define SS_CRC32_SLICE_BY_8 0
+#endif
+
+namespace ss {
+
+/** Frame checksum algorithm. */
+enum class Checksum : uint8_t {
+    None,           ///< No checksum
+    Crc8,           ///< CRC-8    poly 0x07,       init 0x00
+    Crc16,          ///< CRC-16-CCITT poly 0x1021, init 0xFFFF (check 0x29B1)
+    Crc32           ///< CRC-32   IEEE 802.3 (reflected 0xEDB88320)
+};
+
+/**
+ * Name Serial Studio uses for @p c in the project "checksum" field.  Its
+ * plain "CRC-16" is a different (reflected, init 0) variant, so Crc16 goes
+ * by "CRC-16-CCITT".
+ */
+constexpr const char* checksumName(Checksum c) {
+    return c == Checksum::Crc8  ? "CRC-8"  :
+           c == Checksum::Crc16 ? "CRC-16-CCITT" :
+           c == Checksum::Crc32 ? "CRC-32" : "";
+}
+
+/** Number of checksum bytes appended after the end delimiter. */
+constexpr uint8_t checksumSize(Checksum c) {
+    return c == Checksum::Crc8  ? 1 :
+           c == Checksum::Crc16 ? 2 :
+           c == Checksum::Crc32 ? 4 : 0;
+}
+
+/** Incremental checksum over a frame payload. */
+class FrameCrc {
+public:
+    explicit FrameCrc(Checksum algo);
+
+    /** Fold @p len bytes into the running checksum. */
+    void update(const void* data, size_t len);
+
+    /** Final checksum value (after any output XOR). */
+    uint32_t value() const;
+
+    /**
+     * Write the checksum big-endian into @p out (checksumSize() bytes).
+     *
+     * @return Bytes written.
+     */
+    size_t write(char* out) const;
+
+    Checksum algo() const { return algo_; }
+
+private:
+    Checksum algo_;
+    uint32_t crc_;
+};
+
+} // namespace ss
@@ -4,230 +4,1559 @@
  */
 
 #include "ss_dashboard.h"
+#include "ss_project_writer.h"
 #include <cstring>
-#include <cstdio>
-#include <cinttypes>
+#include <cmath>
+#include <cstdlib>
+#include <new>
 
 namespace ss {
 
-// ─── String helpers for enum → JSON ──────────────────────────────────────────
+// ─── SampleRing ──────────────────────────────────────────────────────────────
 
-const char* Dashboard::widgetStr(WidgetType w) {
-    switch (w) {
-        case WidgetType::Gauge: return "gauge";
-        case WidgetType::Bar:   return "bar";
-        case WidgetType::Led:   return "led";
-        default:                return "";
+bool SampleRing::init(uint16_t minCapacity) {
+    uint32_t cap = 16;
+    while (cap < minCapacity) cap <<= 1;
+
+    buf_.reset(new (std::nothrow) float[cap]);
+    mask_ = buf_ ? cap - 1 : 0;
+    head_.store(0, std::memory_order_relaxed);
+    tail_.store(0, std::memory_order_relaxed);
+    return buf_ != nullptr;
+}
+
+// ─── Row-writing helpers ─────────────────────────────────────────────────────
+
+// Append @p n bytes at @p pos, always leaving room for a trailing NUL.
+static bool putBytes(char* buf, size_t bufLen, size_t& pos,
+                     const char* s, size_t n)
+{
+    if (pos + n >= bufLen) return false;
+    memcpy(buf + pos, s, n);
+    pos += n;
+    return true;
+}
+
+// Writes into a fixed char array, dropping whatever does not fit.
+struct TextSink {
+    char*  out;
+    size_t size;
+    size_t cap;
+
+    void put(char c) {
+        if (size < cap) out[size++] = c;
+    }
+};
+
+// Format like "%.6g" into @p scratch (NUL-terminated) without printf.
+static const char* formatFloat(char* scratch, size_t scratchLen, float v) {
+    TextSink sink{scratch, 0, scratchLen - 1};
+    formatNumber(sink, static_cast<double>(v));
+    scratch[sink.size] = '\0';
+    return scratch;
+}
+
+// Current value of a dataset as a float — its held text parsed back, or
+// NaN for string datasets that have no numeric form.
+static float heldValue(const char* text) {
+    if (!text || text[0] == '\0') return 0.0f;
+    char* end = nullptr;
+    const float v = strtof(text, &end);
+    return *end == '\0' ? v : NAN;
+}
+
+// Escaped JSON length of one byte.
+static size_t escapedCost(unsigned char c) {
+    return (c == '"' || c == '\\' || c == '\b' || c == '\f' ||
+            c == '\n' || c == '\r' || c == '\t') ? 2 :
+           c < 0x20 ? 6 : 1;
+}
+
+// Longest prefix of @p val whose escaped JSON form fits in @p width bytes,
+// cut on a UTF-8 character boundary.
+static size_t clipLength(const char* val, uint8_t width) {
+    size_t used = 0;
+    size_t n    = 0;
+    for (; val[n]; ++n) {
+        const size_t cost = escapedCost(static_cast<unsigned char>(val[n]));
+        if (used + cost > width) break;
+        used += cost;
+    }
+    if (val[n] == '\0') return n;
+
+    while (n > 0 && (static_cast<unsigned char>(val[n]) & 0xC0) == 0x80) --n;
+    return n;
+}
+
+// Write @p s JSON-escaped (without quotes) to @p out, or only measure it
+// when @p out is null.  Returns the escaped length.
+static size_t escapeJson(const char* s, char* out) {
+    static constexpr char hex[] = "0123456789abcdef";
+    size_t n = 0;
+    for (; *s; ++s) {
+        const auto   c    = static_cast<unsigned char>(*s);
+        const size_t cost = escapedCost(c);
+        if (out) {
+            char* o = out + n;
+            if (cost == 1) {
+                *o = static_cast<char>(c);
+            } else if (cost == 6) {
+                memcpy(o, "\\u00", 4);
+                o[4] = hex[c >> 4];
+                o[5] = hex[c & 0x0F];
+            } else {
+                o[0] = '\\';
+                o[1] = c == '\b' ? 'b' : c == '\f' ? 'f' : c == '\n' ? 'n' :
+                       c == '\r' ? 'r' : c == '\t' ? 't' : static_cast<char>(c);
+            }
+        }
+        n += cost;
+    }
+    return n;
+}
+
+// FNV-1a, used for the config and layout hashes.
+static constexpr uint32_t kFnvBasis = 2166136261u;
+
+static uint32_t fnv1a(uint32_t h, const void* data, size_t len) {
+    const auto* b = static_cast<const uint8_t*>(data);
+    while (len--) h = (h ^ *b++) * 16777619u;
+    return h;
+}
+
+// ─── Binary payload encoding ─────────────────────────────────────────────────
+
+namespace {
+
+struct HexPairs {
+    char v[512];
+};
+
+constexpr HexPairs makeHexPairs() {
+    constexpr char digits[] = "0123456789ABCDEF";
+    HexPairs t{};
+    for (int b = 0; b < 256; ++b) {
+        t.v[2 * b]     = digits[b >> 4];
+        t.v[2 * b + 1] = digits[b & 0x0F];
+    }
+    return t;
+}
+
+constexpr HexPairs kHexPairs = makeHexPairs();
+constexpr char     kBase64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// Streams a row payload into the frame buffer: text as-is, or packed
+// little-endian float32 values through a lookup-table hex / Base64 encoder.
+// Every byte written is folded into the frame checksum on the way out.
+class PayloadWriter {
+public:
+    PayloadWriter(Decoder decoder, char* buf, size_t bufLen, size_t& pos, FrameCrc& crc)
+        : decoder_(decoder), buf_(buf), bufLen_(bufLen), pos_(pos), crc_(crc) {}
+
+    bool text(const char* s, size_t n) {
+        if (!putBytes(buf_, bufLen_, pos_, s, n)) return false;
+        crc_.update(s, n);
+        return true;
+    }
+
+    bool value(float v) {
+        uint32_t bits;
+        memcpy(&bits, &v, sizeof(bits));
+        const uint8_t raw[4] = {
+            static_cast<uint8_t>(bits),       static_cast<uint8_t>(bits >> 8),
+            static_cast<uint8_t>(bits >> 16), static_cast<uint8_t>(bits >> 24),
+        };
+        return decoder_ == Decoder::Base64 ? base64(raw, 4) : hex(raw, 4);
+    }
+
+    /** Flush the Base64 tail (with '=' padding). */
+    bool finish() {
+        if (decoder_ != Decoder::Base64 || carryLen_ == 0) return true;
+        const uint32_t n = (carry_[0] << 16) |
+                           ((carryLen_ > 1 ? carry_[1] : 0) << 8);
+        const char out[4] = {
+            kBase64[(n >> 18) & 0x3F], kBase64[(n >> 12) & 0x3F],
+            carryLen_ > 1 ? kBase64[(n >> 6) & 0x3F] : '=', '=',
+        };
+        carryLen_ = 0;
+        return text(out, 4);
+    }
+
+private:
+    bool hex(const uint8_t* p, size_t n) {
+        char out[8];
+        for (size_t i = 0; i < n; ++i) memcpy(out + 2 * i, kHexPairs.v + 2 * p[i], 2);
+        return text(out, 2 * n);
+    }
+
+    bool base64(const uint8_t* p, size_t n) {
+        char   out[8];
+        size_t len = 0;
+        for (size_t i = 0; i < n; ++i) {
+            carry_[carryLen_++] = p[i];
+            if (carryLen_ < 3) continue;
+            const uint32_t v = (carry_[0] << 16) | (carry_[1] << 8) | carry_[2];
+            out[len++] = kBase64[(v >> 18) & 0x3F];
+            out[len++] = kBase64[(v >> 12) & 0x3F];
+            out[len++] = kBase64[(v >> 6)  & 0x3F];
+            out[len++] = kBase64[v & 0x3F];
+            carryLen_  = 0;
+        }
+        return text(out, len);
+    }
+
+    Decoder    decoder_;
+    char*      buf_;
+    size_t     bufLen_;
+    size_t&    pos_;
+    FrameCrc&  crc_;
+    uint8_t    carry_[3] = {};
+    uint8_t    carryLen_ = 0;
+};
+
+} // namespace
+
+// ─── Template sinks ──────────────────────────────────────────────────────────
+//
+// ProjectWriter calls hole(ordinal) for every dataset value.  The ordinal is
+// the dataset id, which leads to its value slot; datasets without a slot
+// keep their "0".
+
+// Counts (out == nullptr) or writes one segment, recording where each
+// slot's value goes on the writing pass.
+struct Dashboard::TemplateSink {
+    char*               out;
+    size_t              size;
+    const DatasetEntry* datasets;
+    ValueSlot*          slots;
+    uint8_t             mode;
+    uint32_t            hash;
+
+    void put(char c) {
+        if (out) out[size] = c;
+        ++size;
+        hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+    }
+
+    void hole(uint8_t ordinal) {
+        const uint8_t s = datasets[ordinal].slot;
+        if (s == kNone) {
+            put('0');
+        } else if (out) {
+            slots[s].hole[mode] = static_cast<uint32_t>(size);
+        }
+    }
+};
+
+// Renders JSON with the current values straight into @p buf, failing once
+// @p cap is exceeded.  Used for pretty output when it is not cached.  The
+// structure written since the last value is folded into @p crc at each
+// value and at fold(), so every byte is checksummed right after it is
+// written.
+struct Dashboard::FrameSink {
+    char*               buf;
+    size_t              cap;
+    size_t              pos;
+    bool                ok;
+    const DatasetEntry* datasets;
+    const ValueSlot*    slots;
+    FrameCrc&           crc;
+    size_t              folded;   ///< Bytes of buf already in crc
+
+    void put(char c) {
+        if (pos >= cap) { ok = false; return; }
+        buf[pos++] = c;
+    }
+
+    void hole(uint8_t ordinal) {
+        const uint8_t s = datasets[ordinal].slot;
+        if (s == kNone) {
+            put('0');
+            return;
+        }
+        const size_t n = escapeJson(slots[s].shown(), nullptr);
+        if (pos + n > cap) { ok = false; return; }
+        escapeJson(slots[s].shown(), buf + pos);
+        pos += n;
+        fold();
+    }
+
+    void fold() {
+        crc.update(buf + folded, pos - folded);
+        folded = pos;
     }
+};
+
+// ─── Template cache format ───────────────────────────────────────────────────
+//
+//   header | u32 len[2][2 + groups] | u32 hole[slots][2] | text
+//
+// len[m] lists head, tail, then each group's segment for mode m.  text is
+// every compact segment in that order, followed by the pretty ones when
+// prettyText is set.  All integers are host order; the cache never leaves
+// the device.
+
+namespace {
+
+constexpr uint32_t kTemplateCacheMagic = 0x43545353u;   // "SSTC"
+
+// Bump whenever ProjectWriter's output changes for the same config, so
+// snapshots taken by an older build are not reused.
+constexpr uint8_t kTemplateFormat = 1;
+
+struct TemplateCacheHeader {
+    uint32_t magic;
+    uint32_t configHash;
+    uint32_t size;          ///< Whole snapshot, header included
+    uint32_t crc;           ///< CRC-32 of everything after the header
+    uint8_t  groupCount;
+    uint8_t  slotCount;
+    uint8_t  prettyIndent;
+    uint8_t  prettyText;
+};
+
+uint32_t crc32(const uint8_t* data, size_t len) {
+    FrameCrc crc(Checksum::Crc32);
+    crc.update(data, len);
+    return crc.value();
 }
 
-const char* Dashboard::groupWidgetStr(GroupWidget w) {
-    switch (w) {
-        case GroupWidget::Multiplot:     return "multiplot";
-        case GroupWidget::Datagrid:      return "datagrid";
-        case GroupWidget::Accelerometer: return "accelerometer";
-        default:                         return "";
+// FNV-1a over every config field that reaches the templates or the slots.
+class ConfigHash {
+public:
+    template <typename T>
+    void value(T v) { bytes(&v, sizeof(T)); }
+
+    void text(const char* s) {
+        if (s) bytes(s, strlen(s) + 1);
+        else   value<uint8_t>(0xFF);
     }
+
+    uint32_t get() const { return h_; }
+
+private:
+    void bytes(const void* p, size_t n) { h_ = fnv1a(h_, p, n); }
+
+    uint32_t h_ = kFnvBasis;
+};
+
+uint32_t hashConfig(const DashboardCfg& cfg) {
+    ConfigHash h;
+    h.value(kTemplateFormat);
+    h.text(cfg.title);
+    h.value(cfg.checksum);
+    h.value(cfg.decoder);
+    h.value(cfg.omitDefaults);
+
+    h.value(cfg.actionCount);
+    for (uint8_t i = 0; i < cfg.actionCount; ++i) {
+        const auto& a = cfg.actions[i];
+        h.text(a.title);
+        h.text(a.txData);
+        h.text(a.icon);
+        h.text(a.eol);
+    }
+
+    h.value(cfg.groupCount);
+    for (uint8_t gi = 0; gi < cfg.groupCount; ++gi) {
+        const auto& g = cfg.groups[gi];
+        h.text(g.title);
+        h.value(g.widget);
+        h.value(g.datasetCount);
+        for (uint8_t di = 0; di < g.datasetCount; ++di) {
+            const auto& d = g.datasets[di];
+            h.text(d.title);
+            h.text(d.units);
+            h.text(d.telemetryKey);
+            h.value(d.labelCount);
+            for (uint8_t li = 0; d.labels && li < d.labelCount; ++li) h.text(d.labels[li]);
+            h.value(d.index);
+            h.value(d.widget);
+            h.value(d.widgetMin);
+            h.value(d.widgetMax);
+            h.value(d.plotMin);
+            h.value(d.plotMax);
+            h.value(d.alarmLow);
+            h.value(d.alarmHigh);
+            h.value(d.alarmEnabled);
+            h.value(d.graph);
+            h.value(d.log);
+            h.value(d.led);
+            h.value(d.ledHigh);
+            h.value(d.overviewDisplay);
+            h.value(d.fft);
+            h.value(d.fftSamples);
+            h.value(d.fftSamplingRate);
+            h.value(d.xAxis);
+            h.value(d.aggregate);
+            h.value(d.alarmHysteresis);
+            h.value(d.alarmImmediate);
+            h.value(d.priority);
+            h.value(d.updateEvery);
+            h.value(d.maxRateHz);
+            h.value(d.valueWidth);
+            h.value(d.field.source);
+            h.value(d.field.offset);
+            h.value(d.field.type);
+            h.value(d.kind);
+        }
+    }
+    return h.get();
+}
+
+uint32_t readU32(const uint8_t* p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+void writeU32(uint8_t* p, uint32_t v) {
+    memcpy(p, &v, sizeof(v));
 }
 
+} // namespace
+
 // ─── Construction ────────────────────────────────────────────────────────────
 
 Dashboard::Dashboard(const DashboardCfg& cfg)
     : cfg_(cfg)
+#if SS_DASHBOARD_ARDUINOJSON
+    , telemetry_(&telemetryPool_)
+#endif
 {}
 
-// ─── begin() — build the full JSON structure once ────────────────────────────
+// ─── begin() — build the layout and templates once ───────────────────────────
+
+bool Dashboard::begin(const uint8_t* cache, size_t len) {
+    for (auto& g : groups_) {
+        g.cfg = nullptr;
+        for (auto& seg : g.seg) { seg.text.reset(); seg.len = 0; }
+    }
+    for (auto& d : datasets_) d.cfg = nullptr;
+    for (auto& s : slots_) { s.telemetryKey = nullptr; s.ordinal = kNone; s.text = nullptr; }
+    for (auto& seg : head_) { seg.text.reset(); seg.len = 0; }
+    for (auto& seg : tail_) { seg.text.reset(); seg.len = 0; }
+    begun_           = false;
+    resident_        = !lazy_;
+    projectServed_   = false;
+    slotCount_       = 0;
+    fieldCount_      = 0;
+    ringCount_       = 0;
+    priorityPending_ = false;
+    dueMask_         = ~0ull;
+    schedFrame_      = 0;
+    hkCursor_        = 0;
+    ++layoutVersion_;
+
+    // Ids are handed out lowest-first, so the config's groups and datasets
+    // get the same sequential numbering ProjectWriter::project() uses.
+    bool fits = cfg_.groupCount <= kMaxGroups;
+    for (uint8_t gi = 0; fits && gi < cfg_.groupCount; ++gi) {
+        const auto& grp = cfg_.groups[gi];
+        const int   g   = linkGroup(grp);
+        for (uint8_t di = 0; g >= 0 && di < grp.datasetCount; ++di) {
+            fits = fits && linkDataset(static_cast<uint8_t>(g), grp.datasets[di]) >= 0;
+        }
+    }
+    if (!fits) {
+#ifdef ARDUINO
+        Serial.printf("[ss] begin: config exceeds %u groups / %u datasets\n",
+                      kMaxGroups, kMaxDatasets);
+#endif
+        return false;
+    }
+
+    configHash_ = hashConfig(cfg_);
+    const uint8_t restored = resident_ ? restoreTemplates(cache, len) : 0;
+    restored_ = restored > 0;
+
+    if (!allocValues() || (restored == 0 && !renderFrame(0))) {
+        head_[0].text.reset();
+        return false;
+    }
+    if (restored < 2) renderPretty();
+    updateBounds();
+#if SS_DASHBOARD_ARDUINOJSON
+    buildFilter();
+#endif
+    beginVersion_ = layoutVersion_;
+    begun_        = true;
+    return true;
+}
 
-bool Dashboard::begin() {
-    doc_.clear();
-    slotCount_ = 0;
+void Dashboard::renderPretty() {
+    if (!renderFrame(1)) {
+        prettyCached_ = false;   // fall back to rendering pretty output live
+        renderFrame(1);
+    }
+}
 
-    doc_[ss::Keys::Title] = cfg_.title ? cfg_.title : "Dashboard";
+bool Dashboard::cachePretty(uint8_t indent) {
+    prettyCached_ = indent > 0;
+    prettyIndent_ = indent > 0 ? indent : 2;
+    if (!began()) return true;   // begin() renders it
 
-    buildActions();
+    renderPretty();
+    updateBounds();
+    return prettyCached_ == (indent > 0);
+}
 
-    doc_["checksum"]            = "";
-    doc_["decoder"]             = 0;
-    doc_["hexadecimalDelimiters"] = false;
+// ─── Lazy templates ──────────────────────────────────────────────────────────
 
-    auto layout = doc_[ss::Keys::DashboardLayout].to<JsonObject>();
-    layout["autoLayout"] = true;
-    layout["windowOrder"].to<JsonArray>();
+void Dashboard::setLazy(bool lazy, uint32_t idleReleaseMs) {
+    lazy_          = lazy;
+    idleReleaseMs_ = idleReleaseMs;
+}
 
-    buildGroups();
+bool Dashboard::acquireTemplates() {
+    if (!began()) return false;
+    if (resident_) return true;
 
+    resident_ = true;
+    if (!renderFrame(0)) {
+        releaseTemplates();
+        return false;
+    }
+    renderPretty();
+    projectServed_ = true;   // start the idle clock at the next beginFrame()
     return true;
 }
 
-// ─── buildActions() ──────────────────────────────────────────────────────────
+void Dashboard::releaseTemplates() {
+    resident_ = false;
+    for (uint8_t m = 0; m < 2; ++m) {
+        head_[m].text.reset();
+        tail_[m].text.reset();
+        for (auto& g : groups_) g.seg[m].text.reset();
+    }
+}
 
-void Dashboard::buildActions() {
-    auto actions = doc_[ss::Keys::Actions].to<JsonArray>();
+// ─── Template cache ──────────────────────────────────────────────────────────
 
-    for (uint8_t i = 0; i < cfg_.actionCount; ++i) {
-        const auto& a = cfg_.actions[i];
-        auto obj = actions.add<JsonObject>();
+size_t Dashboard::templateCacheSize() const {
+    if (!began() || !resident_ || layoutVersion_ != beginVersion_) return 0;
 
-        obj[ss::Keys::AutoExecute] = false;
-        obj[ss::Keys::Binary]               = false;
-        obj[ss::Keys::EOL]                  = a.eol  ? a.eol  : "\n";
-        obj[ss::Keys::Icon]                 = a.icon ? a.icon : "";
-        obj[ss::Keys::TimerInterval]        = 100;
-        obj[ss::Keys::TimerMode]            = 0;
-        obj[ss::Keys::Title]                = a.title  ? a.title  : "";
-        obj[ss::Keys::TxData]               = a.txData ? a.txData : "";
+    const size_t segs = 2u + cfg_.groupCount;
+    size_t n = sizeof(TemplateCacheHeader) + 2 * segs * 4 + slotCount_ * 8u;
+    for (uint8_t m = 0; m < (prettyCached_ ? 2 : 1); ++m) {
+        n += head_[m].len + tail_[m].len;
+        for (uint8_t g = 0; g < cfg_.groupCount; ++g) n += groups_[g].seg[m].len;
     }
+    return n;
 }
 
-// ─── buildGroups() ───────────────────────────────────────────────────────────
+size_t Dashboard::saveTemplates(uint8_t* buf, size_t cap) const {
+    const size_t size = templateCacheSize();
+    if (!buf || size == 0 || size > cap) return 0;
 
-void Dashboard::buildGroups() {
-    auto groups = doc_[ss::Keys::Groups].to<JsonArray>();
+    auto segment = [this](uint8_t m, size_t i) -> const Segment& {
+        return i == 0 ? head_[m] : i == 1 ? tail_[m] : groups_[i - 2].seg[m];
+    };
+    const size_t segs = 2u + cfg_.groupCount;
 
-    // Auto-assigned, 1-based index that increments across every dataset in
-    // every group.  Serial Studio uses this for colour assignment and it must
-    // be present and unique — even for datasets whose config leaves .index at 0.
-    uint8_t autoIndex = 1;
+    uint8_t* p = buf + sizeof(TemplateCacheHeader);
+    for (uint8_t m = 0; m < 2; ++m) {
+        for (size_t i = 0; i < segs; ++i, p += 4) writeU32(p, static_cast<uint32_t>(segment(m, i).len));
+    }
+    for (uint8_t s = 0; s < slotCount_; ++s, p += 8) {
+        writeU32(p,     slots_[s].hole[0]);
+        writeU32(p + 4, slots_[s].hole[1]);
+    }
+    for (uint8_t m = 0; m < (prettyCached_ ? 2 : 1); ++m) {
+        for (size_t i = 0; i < segs; ++i) {
+            const Segment& seg = segment(m, i);
+            memcpy(p, seg.text.get(), seg.len);
+            p += seg.len;
+        }
+    }
 
-    for (uint8_t gi = 0; gi < cfg_.groupCount; ++gi) {
-        const auto& grp = cfg_.groups[gi];
-        auto gObj = groups.add<JsonObject>();
-
-        gObj[ss::Keys::Title]  = grp.title ? grp.title : "";
-        gObj[ss::Keys::Widget] = groupWidgetStr(grp.widget);
-
-        auto datasets = gObj[ss::Keys::Datasets].to<JsonArray>();
-
-        for (uint8_t di = 0; di < grp.datasetCount; ++di) {
-            const auto& ds = grp.datasets[di];
-            auto dObj = datasets.add<JsonObject>();
-
-            dObj[ss::Keys::AlarmEnabled]    = ds.alarmEnabled;
-            dObj[ss::Keys::AlarmHigh]       = ds.alarmHigh;
-            dObj[ss::Keys::AlarmLow]        = ds.alarmLow;
-            dObj[ss::Keys::FFT]             = ds.fft;
-            dObj[ss::Keys::FFTMax]          = 0;
-            dObj[ss::Keys::FFTMin]          = 0;
-            dObj[ss::Keys::FFTSamples]      = ds.fftSamples;
-            dObj[ss::Keys::FFTSamplingRate] = ds.fftSamplingRate;
-            dObj[ss::Keys::Graph]           = ds.graph;
-            dObj[ss::Keys::Index]           = autoIndex++;
-            dObj[ss::Keys::LED]             = ds.led;
-            dObj[ss::Keys::LedHigh]         = ds.ledHigh;
-            dObj[ss::Keys::Log]             = ds.log;
-            dObj[ss::Keys::Overview]        = ds.overviewDisplay;
-            dObj[ss::Keys::PltMax]          = ds.plotMax;
-            dObj[ss::Keys::PltMin]          = ds.plotMin;
-            dObj[ss::Keys::Title]           = ds.title ? ds.title : "";
-            dObj[ss::Keys::Units]           = ds.units ? ds.units : "";
-            dObj[ss::Keys::Value]           = "0";   // placeholder — update() patches this
-            dObj[ss::Keys::Widget]          = widgetStr(ds.widget);
-            dObj[ss::Keys::WgtMax]          = ds.widgetMax;
-            dObj[ss::Keys::WgtMin]          = ds.widgetMin;
-            dObj[ss::Keys::XAxis]           = ds.xAxis;
-
-            // Register a value slot if we have a telemetry key
-            if (ds.telemetryKey && ds.telemetryKey[0] != '\0' &&
-                slotCount_ < kMaxSlots)
-            {
-                slots_[slotCount_++] = {ds.telemetryKey, gi, di};
+    const TemplateCacheHeader h = {
+        kTemplateCacheMagic, configHash_, static_cast<uint32_t>(size),
+        crc32(buf + sizeof(h), size - sizeof(h)),
+        cfg_.groupCount, slotCount_, prettyIndent_, prettyCached_ ? uint8_t{1} : uint8_t{0},
+    };
+    memcpy(buf, &h, sizeof(h));
+    return size;
+}
+
+uint8_t Dashboard::restoreTemplates(const uint8_t* cache, size_t len) {
+    TemplateCacheHeader h;
+    if (!cache || len < sizeof(h)) return 0;
+    memcpy(&h, cache, sizeof(h));
+
+    const size_t segs    = 2u + h.groupCount;
+    const size_t holesAt = sizeof(h) + 2 * segs * 4;
+    const size_t textAt  = holesAt + h.slotCount * 8u;
+    if (h.magic != kTemplateCacheMagic || h.configHash != configHash_ ||
+        h.groupCount != cfg_.groupCount || h.slotCount != slotCount_ ||
+        h.size > len || h.size < textAt ||
+        h.crc != crc32(cache + sizeof(h), h.size - sizeof(h))) {
+        return 0;
+    }
+
+    // Pretty lengths and holes depend on the indent; its text is only there
+    // if it was cached when the snapshot was taken.
+    const bool    pretty = h.prettyIndent == prettyIndent_ && (h.prettyText || !prettyCached_);
+    const uint8_t modes  = pretty ? 2 : 1;
+
+    size_t text = 0;
+    for (uint8_t m = 0; m < (h.prettyText ? 2 : 1); ++m) {
+        for (size_t i = 0; i < segs; ++i) text += readU32(cache + sizeof(h) + (m * segs + i) * 4);
+    }
+    if (textAt + text != h.size) return 0;
+
+    const uint8_t* src = cache + textAt;
+    for (uint8_t m = 0; m < 2; ++m) {
+        const bool store = m == 0 || (pretty && prettyCached_);
+        for (size_t i = 0; i < segs; ++i) {
+            const size_t n   = readU32(cache + sizeof(h) + (m * segs + i) * 4);
+            Segment&     seg = i == 0 ? head_[m] : i == 1 ? tail_[m] : groups_[i - 2].seg[m];
+            if (m < modes) {
+                seg.len = n;
+                if (m == 0) seg.hash = fnv1a(kFnvBasis, src, n);
+                if (store) {
+                    seg.text.reset(new (std::nothrow) char[n ? n : 1]);
+                    if (!seg.text) return 0;   // begin() renders instead
+                    memcpy(seg.text.get(), src, n);
+                }
             }
+            if (m == 0 || h.prettyText) src += n;
         }
     }
+    for (uint8_t s = 0; s < h.slotCount; ++s) {
+        slots_[s].hole[0] = readU32(cache + holesAt + s * 8u);
+        if (pretty) slots_[s].hole[1] = readU32(cache + holesAt + s * 8u + 4);
+    }
+    return modes;
 }
 
-// ─── resolveKey() — navigate dotted path in JSON ─────────────────────────────
+// ─── Runtime layout ──────────────────────────────────────────────────────────
 
-const char* Dashboard::resolveKey(const JsonDocument& doc,
-                                  const char* dottedKey,
-                                  char* scratch,
-                                  size_t scratchLen)
-{
-    if (!dottedKey || dottedKey[0] == '\0') return nullptr;
+int Dashboard::linkGroup(const GroupCfg& g) {
+    for (uint8_t id = 0; id < kMaxGroups; ++id) {
+        auto& e = groups_[id];
+        if (e.cfg) continue;
+        e.cfg     = &g;
+        e.enabled = true;
+        e.first   = kNone;
+        for (auto& seg : e.seg) { seg.text.reset(); seg.len = 0; }
+        return id;
+    }
+    return -1;
+}
 
-    // Copy key so we can tokenise it (strtok-style, but without modifying
-    // the original).  Max depth = 4 levels should be more than enough.
-    char keyBuf[64];
-    const size_t keyLen = strlen(dottedKey);
-    if (keyLen >= sizeof(keyBuf)) return nullptr;
-    memcpy(keyBuf, dottedKey, keyLen + 1);
+// Kind a struct member's type implies, for ValueKind::Auto datasets.
+static ValueKind fieldKind(FieldType type) {
+    switch (type) {
+        case FieldType::Bool: return ValueKind::Bool;
+        case FieldType::U8:
+        case FieldType::U16:
+        case FieldType::U32:  return ValueKind::UInt;
+        case FieldType::I8:
+        case FieldType::I16:
+        case FieldType::I32:  return ValueKind::Int;
+        case FieldType::F32:
+        case FieldType::F64:  return ValueKind::Float;
+        case FieldType::None: break;
+    }
+    return ValueKind::Auto;
+}
 
-    // Walk the JSON tree one segment at a time.
-    JsonVariantConst node = doc.as<JsonVariantConst>();
+int Dashboard::linkDataset(uint8_t group, const DatasetCfg& ds) {
+    uint8_t id = 0;
+    while (id < kMaxDatasets && datasets_[id].cfg) ++id;
+    if (id == kMaxDatasets) return -1;
 
-    char* savePtr = nullptr;
-    char* token   = strtok_r(keyBuf, ".", &savePtr);
-    while (token) {
-        if (!node.is<JsonObjectConst>()) return nullptr;
-        node = node[token];
-        if (node.isNull()) return nullptr;
-        token = strtok_r(nullptr, ".", &savePtr);
+    // Register a value slot if the dataset has a source of values: a
+    // telemetry key, a struct field, or both.
+    const bool hasKey = ds.telemetryKey && ds.telemetryKey[0] != '\0';
+    uint8_t    slot   = kNone;
+    if (hasKey || ds.field.type != FieldType::None) {
+        uint8_t s = 0;
+        while (s < kMaxSlots && slots_[s].used()) ++s;
+        if (s < kMaxSlots) {
+            int8_t ring = -1;
+            if (ds.fft) {
+                uint8_t r = 0;
+                while (r < ringCount_ && ringSlots_[r] != kNone) ++r;
+                if (r < kMaxFftSlots && rings_[r].init(ds.fftSamples)) {
+                    ringSlots_[r] = s;
+                    ring = static_cast<int8_t>(r);
+                    if (r == ringCount_) ++ringCount_;
+                }
+            }
+            slots_[s] = {
+                hasKey ? ds.telemetryKey : nullptr, id, ring, ds.aggregate, maxValueWidth(ds),
+                nullptr, {0, 0}, {},
+                {ds.alarmEnabled, ds.alarmImmediate, AlarmState::Normal,
+                 ds.alarmLow, ds.alarmHigh, ds.alarmHysteresis},
+                {ds.priority,
+                 static_cast<uint8_t>(ds.updateEvery > 1 ? ds.updateEvery : 1),
+                 static_cast<uint16_t>(ds.maxRateHz ? 1000u / ds.maxRateHz : 0u),
+                 0, false},
+                ds.field,
+                ds.kind != ValueKind::Auto ? ds.kind :
+                ds.labels                  ? ValueKind::Enum : fieldKind(ds.field.type),
+                ds.labels, static_cast<uint8_t>(ds.labels ? ds.labelCount : 0), kNone,
+            };
+            if (s >= slotCount_) slotCount_ = s + 1;
+            slot = s;
+        }
+#ifdef ARDUINO
+        if (slot == kNone) {
+            Serial.printf("[ss] no free value slot for dataset %u (SS_MAX_SLOTS %u)\n",
+                          id, kMaxSlots);
+        }
+#endif
     }
 
-    // Convert the leaf to a string.
-    if (node.is<const char*>()) {
-        return node.as<const char*>();
+    // Keep the group's list in id order, which is its JSON order.
+    uint8_t* link = &groups_[group].first;
+    while (*link != kNone && *link < id) link = &datasets_[*link].next;
+    datasets_[id] = {&ds, group, *link, slot, true};
+    *link = id;
+
+    if (id >= fieldCount_) fieldCount_ = id + 1;
+    return id;
+}
+
+void Dashboard::unlinkDataset(uint8_t id) {
+    auto& d = datasets_[id];
+
+    uint8_t* link = &groups_[d.group].first;
+    while (*link != id) link = &datasets_[*link].next;
+    *link = d.next;
+
+    if (d.slot != kNone) {
+        auto& s = slots_[d.slot];
+        if (s.ring >= 0) ringSlots_[s.ring] = kNone;
+        s.telemetryKey = nullptr;
+        s.ordinal      = kNone;
+        s.ring         = -1;
+        while (slotCount_ > 0 && !slots_[slotCount_ - 1].used()) --slotCount_;
     }
-    if (node.is<float>()) {
-        snprintf(scratch, scratchLen, "%.6g", static_cast<double>(node.as<float>()));
-        return scratch;
+
+    d.cfg = nullptr;
+    while (fieldCount_ > 0 && !datasets_[fieldCount_ - 1].cfg) --fieldCount_;
+}
+
+void Dashboard::dropGroup(uint8_t g) {
+    while (groups_[g].first != kNone) unlinkDataset(groups_[g].first);
+    for (auto& seg : groups_[g].seg) { seg.text.reset(); seg.len = 0; }
+    groups_[g].cfg = nullptr;
+}
+
+int Dashboard::addGroup(const GroupCfg& group) {
+    if (!began()) return -1;
+    const int g = linkGroup(group);
+    if (g < 0) return -1;
+
+    const auto id = static_cast<uint8_t>(g);
+    bool ok = true;
+    for (uint8_t di = 0; ok && di < group.datasetCount; ++di) {
+        ok = linkDataset(id, group.datasets[di]) >= 0;
     }
-    if (node.is<int64_t>()) {
-        snprintf(scratch, scratchLen, "%" PRId64, node.as<int64_t>());
-        return scratch;
+    if (!ok || !allocValues() || !relayout(id)) {
+        dropGroup(id);
+        updateBounds();
+        return -1;
     }
-    if (node.is<uint64_t>()) {
-        snprintf(scratch, scratchLen, "%" PRIu64, node.as<uint64_t>());
-        return scratch;
+    return g;
+}
+
+int Dashboard::addDataset(uint8_t group, const DatasetCfg& dataset) {
+    if (!began() || group >= kMaxGroups || !groups_[group].cfg) return -1;
+    const int id = linkDataset(group, dataset);
+    if (id < 0) return -1;
+
+    if (!allocValues() || !relayout(group)) {
+        unlinkDataset(static_cast<uint8_t>(id));
+        relayout(group);
+        return -1;
     }
-    if (node.is<bool>()) {
-        snprintf(scratch, scratchLen, "%u", node.as<bool>() ? 1u : 0u);
-        return scratch;
+    return id;
+}
+
+bool Dashboard::removeGroup(uint8_t group) {
+    if (group >= kMaxGroups || !groups_[group].cfg) return false;
+    dropGroup(group);
+    updateBounds();
+    ++layoutVersion_;
+    return true;
+}
+
+bool Dashboard::removeDataset(uint8_t dataset) {
+    if (dataset >= kMaxDatasets || !datasets_[dataset].cfg) return false;
+    const uint8_t group = datasets_[dataset].group;
+    unlinkDataset(dataset);
+    return relayout(group);
+}
+
+bool Dashboard::setGroupEnabled(uint8_t group, bool enabled) {
+    if (group >= kMaxGroups || !groups_[group].cfg) return false;
+    if (groups_[group].enabled != enabled) {
+        groups_[group].enabled = enabled;   // segment is kept, only skipped
+        updateBounds();
+        ++layoutVersion_;
     }
-    return nullptr;
+    return true;
 }
 
-// ─── update() — patch all "value" fields from telemetry ──────────────────────
+bool Dashboard::setDatasetEnabled(uint8_t dataset, bool enabled) {
+    if (dataset >= kMaxDatasets || !datasets_[dataset].cfg) return false;
+    if (datasets_[dataset].enabled == enabled) return true;
+    datasets_[dataset].enabled = enabled;
+    return relayout(datasets_[dataset].group);
+}
 
-void Dashboard::update(const JsonDocument& telemetry) {
-    char scratch[32];
+bool Dashboard::relayout(uint8_t g) {
+    const bool ok = renderGroup(g, 0) && renderGroup(g, 1);
+    updateBounds();
+    ++layoutVersion_;
+    return ok;
+}
 
-    auto groups = doc_[ss::Keys::Groups].as<JsonArray>();
+// ─── Templates ───────────────────────────────────────────────────────────────
 
+bool Dashboard::allocValues() {
+    size_t valuesLen = 0;
     for (uint8_t s = 0; s < slotCount_; ++s) {
-        const auto& slot = slots_[s];
+        if (slots_[s].used()) valuesLen += slots_[s].width + 1u;
+    }
 
-        const char* val = resolveKey(telemetry, slot.telemetryKey,
-                                     scratch, sizeof(scratch));
-        if (!val) continue;
+    std::unique_ptr<char[]> values(new (std::nothrow) char[valuesLen ? valuesLen : 1]);
+    if (!values) {
+#ifdef ARDUINO
+        Serial.printf("[ss] cannot allocate %u bytes of value text\n",
+                      static_cast<unsigned>(valuesLen));
+#endif
+        return false;
+    }
 
-        // Navigate to the dataset and set "value".
-        auto ds = groups[slot.groupIdx][ss::Keys::Datasets][slot.datasetIdx];
-        if (!ds.isNull()) {
-            ds[ss::Keys::Value] = val;
+    char* text = values.get();
+    for (uint8_t s = 0; s < slotCount_; ++s) {
+        auto& slot = slots_[s];
+        if (!slot.used()) continue;
+        if (slot.text) {
+            memcpy(text, slot.text, strlen(slot.text) + 1);
+        } else {
+            text[0] = '0';
+            text[1] = '\0';
         }
+        slot.text = text;
+        text += slot.width + 1u;
     }
+    values_    = std::move(values);
+    valuesLen_ = valuesLen;
+    return true;
 }
 
-static const char* iconToString(DashboardIcon icon) {
-    auto it = DashboardIconMap.find(icon);
-    if (it != DashboardIconMap.end()) {
-        return it->second.c_str();
+template <typename Draw>
+bool Dashboard::renderSegment(Segment& seg, uint8_t mode, Draw draw) {
+    // Two passes through the same writer: size, then fill.
+    const uint8_t indent = mode ? prettyIndent_ : 0;
+    TemplateSink  count{nullptr, 0, datasets_, slots_, mode, kFnvBasis};
+    ProjectWriter<TemplateSink> sizer(count, indent);
+    draw(sizer);
+    seg.hash = count.hash;
+
+    if (!resident_ || (mode == 1 && !prettyCached_)) {
+        seg.text.reset();
+        seg.len = count.size;
+        return true;
     }
-    return nullptr;
+
+    std::unique_ptr<char[]> text(new (std::nothrow) char[count.size]);
+    if (!text) {
+#ifdef ARDUINO
+        Serial.printf("[ss] cannot allocate %u-byte template\n",
+                      static_cast<unsigned>(count.size));
+#endif
+        return false;
+    }
+
+    TemplateSink fill{text.get(), 0, datasets_, slots_, mode, kFnvBasis};
+    ProjectWriter<TemplateSink> writer(fill, indent);
+    draw(writer);
+    seg.text = std::move(text);
+    seg.len  = fill.size;
+    return true;
+}
+
+template <typename Writer>
+void Dashboard::drawGroup(Writer& w, uint8_t g) const {
+    w.groupOpen(*groups_[g].cfg);
+    for (uint8_t d = groups_[g].first; d != kNone; d = datasets_[d].next) {
+        if (datasets_[d].enabled) w.dataset(*datasets_[d].cfg, static_cast<uint8_t>(d + 1));
+    }
+    w.groupClose();
+}
+
+bool Dashboard::renderGroup(uint8_t g, uint8_t mode) {
+    return renderSegment(groups_[g].seg[mode], mode, [this, g](auto& w) {
+        w.enterGroups(cfg_, false);
+        drawGroup(w, g);
+    });
+}
+
+bool Dashboard::renderFrame(uint8_t mode) {
+    bool ok = renderSegment(head_[mode], mode, [this](auto& w) { w.header(cfg_); }) &&
+              renderSegment(tail_[mode], mode, [this](auto& w) {
+                  w.enterGroups(cfg_, true);
+                  w.footer();
+              });
+    for (uint8_t g = 0; ok && g < kMaxGroups; ++g) {
+        if (groups_[g].cfg) ok = renderGroup(g, mode);
+    }
+    return ok;
+}
+
+size_t Dashboard::tailSkip(uint8_t mode) const {
+    // The tail is rendered after a group.  With none shown, pretty output
+    // closes the empty array straight away: drop the line break and indent.
+    if (mode == 0) return 0;
+    for (const auto& g : groups_) {
+        if (g.cfg && g.enabled) return 0;
+    }
+    return 2 + prettyIndent_;
+}
+
+size_t Dashboard::jsonLength(uint8_t mode, bool worst) const {
+    char   scratch[256];   // width + 1 <= 256
+    size_t n     = head_[mode].len + tail_[mode].len - tailSkip(mode);
+    bool   first = true;
+    for (const auto& g : groups_) {
+        if (!g.cfg || !g.enabled) continue;
+        n += g.seg[mode].len + (first ? 0 : 1);
+        first = false;
+        for (uint8_t d = g.first; d != kNone; d = datasets_[d].next) {
+            const auto& e = datasets_[d];
+            if (!e.enabled || e.slot == kNone) continue;
+            n += worst ? slots_[e.slot].width
+                       : escapeJson(preview(e.slot, scratch), nullptr);
+        }
+    }
+    return n;
+}
+
+size_t Dashboard::splice(uint8_t mode, char* out, FrameCrc& crc) const {
+    char* p    = out;
+    auto  copy = [&](const char* src, size_t n) {
+        memcpy(p, src, n);
+        crc.update(src, n);
+        p += n;
+    };
+    bool first = true;
+
+    copy(head_[mode].text.get(), head_[mode].len);
+    for (const auto& g : groups_) {
+        if (!g.cfg || !g.enabled) continue;
+        if (!first) copy(",", 1);
+        first = false;
+
+        // Segment text with each slot's escaped value in its hole.
+        const char* tpl  = g.seg[mode].text.get();
+        size_t      from = 0;
+        for (uint8_t d = g.first; d != kNone; d = datasets_[d].next) {
+            const auto& e = datasets_[d];
+            if (!e.enabled || e.slot == kNone) continue;
+            const auto& s = slots_[e.slot];
+            copy(tpl + from, s.hole[mode] - from);
+            const size_t n = escapeJson(s.shown(), p);
+            crc.update(p, n);
+            p   += n;
+            from = s.hole[mode];
+        }
+        copy(tpl + from, g.seg[mode].len - from);
+    }
+    const size_t skip = tailSkip(mode);
+    copy(tail_[mode].text.get() + skip, tail_[mode].len - skip);
+    return static_cast<size_t>(p - out);
+}
+
+void Dashboard::updateBounds() {
+    const uint8_t sumLen = checksumSize(cfg_.checksum);
+    maxCompactSize_ = jsonLength(0, true) + 7  + sumLen;
+    maxPrettySize_  = jsonLength(1, true) + 10 + sumLen;
+
+    // Data rows carry every id up to the highest, shown or not; gaps are "0".
+    size_t text = 0;
+    for (uint8_t d = 0; d < fieldCount_; ++d) {
+        const auto& e = datasets_[d];
+        text += (e.cfg && e.slot != kNone) ? slots_[e.slot].width : 1u;
+    }
+    maxRowSize_ = dataRowSize(cfg_.decoder, cfg_.checksum, fieldCount_, text);
+
+    // Chain the shown compact segments in order; values sit in holes that
+    // add no text, so only the structure counts.
+    uint32_t h = fnv1a(kFnvBasis, &head_[0].hash, sizeof(uint32_t));
+    for (const auto& g : groups_) {
+        if (g.cfg && g.enabled) h = fnv1a(h, &g.seg[0].hash, sizeof(uint32_t));
+    }
+    layoutHash_ = fnv1a(h, &tail_[0].hash, sizeof(uint32_t));
+}
+
+// ─── Refresh scheduling ──────────────────────────────────────────────────────
+
+uint8_t Dashboard::beginFrame(uint32_t nowMs) {
+    // Lazy templates follow demand: built once a project frame is asked
+    // for, released after idleReleaseMs_ without one.
+    if (lazy_ && began()) {
+        if (projectServed_) {
+            projectServed_ = false;
+            lastServedMs_  = nowMs;
+            if (!resident_) acquireTemplates();
+        } else if (resident_ && idleReleaseMs_ && nowMs - lastServedMs_ >= idleReleaseMs_) {
+            releaseTemplates();
+        }
+    }
+
+    const uint32_t frame = schedFrame_++;
+    uint64_t mask = 0;
+    uint8_t  due  = 0;
+
+    // Divisor and rate limit, common to Normal and Housekeeping slots.
+    auto eligible = [&](const ValueSlot::Schedule& sc, uint8_t s) {
+        if ((frame + s) % sc.every != 0) return false;
+        return !sc.ran || sc.minPeriodMs == 0 || nowMs - sc.lastMs >= sc.minPeriodMs;
+    };
+    auto take = [&](uint8_t s) {
+        mask |= 1ull << s;
+        slots_[s].sched.lastMs = nowMs;
+        slots_[s].sched.ran    = true;
+        ++due;
+    };
+
+    for (uint8_t s = 0; s < slotCount_; ++s) {
+        if (!slots_[s].used()) continue;
+        const auto& sc = slots_[s].sched;
+        if (sc.priority == Priority::Critical ||
+            (sc.priority == Priority::Normal && eligible(sc, s)))
+        {
+            take(s);
+        }
+    }
+
+    // Housekeeping slots share what is left, starting where the previous
+    // frame stopped so every one of them gets a turn.
+    uint8_t budget = hkBudget_;
+    for (uint8_t n = 0; n < slotCount_ && budget > 0; ++n) {
+        const uint8_t s = static_cast<uint8_t>((hkCursor_ + n) % slotCount_);
+        const auto&   sc = slots_[s].sched;
+        if (!slots_[s].used()) continue;
+        if (sc.priority != Priority::Housekeeping || !eligible(sc, s)) continue;
+        take(s);
+        --budget;
+        hkCursor_ = static_cast<uint8_t>((s + 1) % slotCount_);
+    }
+
+    dueMask_ = mask;
+    return due;
+}
+
+// ─── Aggregation windows ─────────────────────────────────────────────────────
+
+void Dashboard::setValue(uint8_t slot, float value) {
+    if (hasSlot(slot)) feed(slot, value);
+}
+
+void Dashboard::setText(uint8_t slot, const char* text) {
+    if (text && hasSlot(slot)) storeText(slot, text);
+}
+
+namespace {
+
+template <typename T>
+T loadAs(const uint8_t* p) {
+    T v;
+    memcpy(&v, p, sizeof v);
+    return v;
+}
+
+} // namespace
+
+void Dashboard::update(const void* data, uint8_t source) {
+    if (!data) return;
+    const auto* base = static_cast<const uint8_t*>(data);
+    for (uint8_t s = 0; s < slotCount_; ++s) {
+        const FieldRef& f = slots_[s].field;
+        if (f.type == FieldType::None || f.source != source) continue;
+
+        // The member's type picks the handler; integers stay exact.
+        const uint8_t* p = base + f.offset;
+        switch (f.type) {
+            case FieldType::Bool: feed(s, *p ? 1.0f : 0.0f);                  break;
+            case FieldType::U8:   feedUInt(s, loadAs<uint8_t>(p));            break;
+            case FieldType::I8:   feedInt(s, loadAs<int8_t>(p));              break;
+            case FieldType::U16:  feedUInt(s, loadAs<uint16_t>(p));           break;
+            case FieldType::I16:  feedInt(s, loadAs<int16_t>(p));             break;
+            case FieldType::U32:  feedUInt(s, loadAs<uint32_t>(p));           break;
+            case FieldType::I32:  feedInt(s, loadAs<int32_t>(p));             break;
+            case FieldType::F32:  feed(s, loadAs<float>(p));                  break;
+            case FieldType::F64:  feed(s, static_cast<float>(loadAs<double>(p))); break;
+            case FieldType::None: break;
+        }
+    }
+}
+
+void Dashboard::feed(uint8_t slot, float x) {
+    auto& s = slots_[slot];
+    auto& w = s.window;
+
+    // Alarms see every raw sample, not the aggregate, so a spike between
+    // frames still trips them.
+    if (s.alarm.enabled) checkAlarm(slot, x);
+
+    // A window lives until the next frame the slot is due in (see
+    // closeWindows()).
+    if (w.closed) w.count = 0;
+    w.closed  = false;
+    w.pending = Pending::Window;
+
+    if (w.count == 0) {
+        w.acc = (s.aggregate == Aggregate::Rms) ? x * x : x;
+    } else {
+        switch (s.aggregate) {
+            case Aggregate::Min:      if (x < w.acc) w.acc = x;                   break;
+            case Aggregate::Max:      if (x > w.acc) w.acc = x;                   break;
+            case Aggregate::Mean:     w.acc += x;                                 break;
+            case Aggregate::Rms:      w.acc += x * x;                             break;
+            case Aggregate::PeakHold: if (fabsf(x) > fabsf(w.acc)) w.acc = x;     break;
+            default:                  w.acc = x;                                  break;
+        }
+    }
+    ++w.count;
+}
+
+const char* Dashboard::preview(uint8_t slot, char* scratch) const {
+    const auto& s = slots_[slot];
+    const auto& w = s.window;
+    if (w.pending == Pending::None || !isDue(slot)) return s.shown();
+
+    switch (w.pending) {
+        case Pending::Window: {
+            float out = w.acc;
+            if (s.aggregate == Aggregate::Mean) out = w.acc / w.count;
+            if (s.aggregate == Aggregate::Rms)  out = sqrtf(w.acc / w.count);
+            formatFloat(scratch, s.width + 1u, out);   // width >= kNumericValueWidth
+            return scratch;
+        }
+        case Pending::Integer: {
+            char     digits[20];
+            size_t   n         = 0;
+            uint64_t magnitude = w.exact;
+            do {
+                digits[n++] = static_cast<char>('0' + magnitude % 10);
+                magnitude /= 10;
+            } while (magnitude);
+
+            char* out = scratch;
+            if (w.negative) *out++ = '-';
+            while (n) *out++ = digits[--n];
+            *out = '\0';
+            return scratch;
+        }
+        case Pending::Label:
+            return s.labels[w.exact];
+        case Pending::None:
+            break;
+    }
+    return s.shown();
+}
+
+void Dashboard::publish(uint8_t slot) {
+    auto& s = slots_[slot];
+    auto& w = s.window;
+    if (w.pending == Pending::None || !isDue(slot)) return;
+
+    if (w.pending == Pending::Label) {
+        s.label = static_cast<uint8_t>(w.exact);
+    } else {
+        preview(slot, s.text);
+        s.label = kNone;
+    }
+    w.pending = Pending::None;
+}
+
+void Dashboard::syncValues() {
+    for (uint8_t s = 0; s < slotCount_; ++s) {
+        if (slots_[s].used()) publish(s);
+    }
+}
+
+void Dashboard::closeWindows() {
+    // Only windows that were shown close; the others keep folding samples
+    // until their slot is due.  Peak-hold spans frames until clearPeaks().
+    for (uint8_t s = 0; s < slotCount_; ++s) {
+        if (isDue(s) && slots_[s].aggregate != Aggregate::PeakHold) {
+            slots_[s].window.closed = true;
+        }
+    }
+}
+
+void Dashboard::feedInt(uint8_t slot, int64_t x) {
+    const uint64_t magnitude = x < 0 ? 0u - static_cast<uint64_t>(x) : static_cast<uint64_t>(x);
+    feedInteger(slot, magnitude, x < 0);
+}
+
+void Dashboard::feedUInt(uint8_t slot, uint64_t x) {
+    feedInteger(slot, x, false);
+}
+
+void Dashboard::feedInteger(uint8_t slot, uint64_t magnitude, bool negative) {
+    auto&       s = slots_[slot];
+    const float x = negative ? -static_cast<float>(magnitude) : static_cast<float>(magnitude);
+
+    // A state with a name is shown by reference; anything else is a number.
+    if (!negative && magnitude < s.labelCount && s.labels[magnitude]) {
+        showLabel(slot, static_cast<uint8_t>(magnitude));
+        return;
+    }
+
+    size_t n = 1;
+    for (uint64_t m = magnitude / 10; m; m /= 10) ++n;
+
+    // Aggregates are float math, and a number wider than the slot would be
+    // cut short; both take the float path.
+    if (s.aggregate != Aggregate::Last || n + negative > s.width) {
+        feed(slot, x);
+        return;
+    }
+    if (s.alarm.enabled) checkAlarm(slot, x);
+
+    // Printed by publish(), once the slot is due.
+    s.window.pending  = Pending::Integer;
+    s.window.exact    = magnitude;
+    s.window.negative = negative;
+}
+
+void Dashboard::showLabel(uint8_t slot, uint8_t index) {
+    auto& s = slots_[slot];
+    if (s.alarm.enabled) checkAlarm(slot, index);
+    s.window.pending = Pending::Label;
+    s.window.exact   = index;
+}
+
+void Dashboard::clearPeaks() {
+    for (uint8_t s = 0; s < slotCount_; ++s) {
+        if (slots_[s].aggregate == Aggregate::PeakHold) slots_[s].window.count = 0;
+    }
+}
+
+// ─── Alarm evaluation ────────────────────────────────────────────────────────
+
+void Dashboard::checkAlarm(uint8_t slot, float x) {
+    auto& a = slots_[slot].alarm;
+    const AlarmState prev = a.state;
+
+    // Leave an active state only once the value is back past the threshold
+    // by the hysteresis band; enter on the threshold itself.
+    AlarmState next = prev;
+    if (prev == AlarmState::High && x < a.high - a.hysteresis) next = AlarmState::Normal;
+    if (prev == AlarmState::Low  && x > a.low  + a.hysteresis) next = AlarmState::Normal;
+    if (x >= a.high)     next = AlarmState::High;
+    else if (x <= a.low) next = AlarmState::Low;
+
+    if (next == prev) return;
+    a.state = next;
+
+    // The frame this transition is reported in carries the new value.
+    dueMask_ |= 1ull << slot;
+
+    if (a.immediate) priorityPending_ = true;
+    if (alarmCb_) {
+        const AlarmEvent ev = {slot, slots_[slot].telemetryKey, next, prev, x};
+        alarmCb_(alarmCtx_, ev);
+    }
+}
+
+void Dashboard::onAlarm(AlarmCallback cb, void* ctx) {
+    alarmCb_  = cb;
+    alarmCtx_ = ctx;
+}
+
+AlarmState Dashboard::alarmState(uint8_t slot) const {
+    return slot < slotCount_ ? slots_[slot].alarm.state : AlarmState::Normal;
+}
+
+// ─── FFT sample rings ────────────────────────────────────────────────────────
+
+int Dashboard::findSlot(const char* telemetryKey) const {
+    if (!telemetryKey) return -1;
+    for (uint8_t s = 0; s < slotCount_; ++s) {
+        const char* key = slots_[s].telemetryKey;
+        if (key && strcmp(key, telemetryKey) == 0) return s;
+    }
+    return -1;
+}
+
+bool Dashboard::pushSample(uint8_t slot, float value) {
+    if (slot >= slotCount_ || slots_[slot].ring < 0) return false;
+    return rings_[slots_[slot].ring].push(value);
+}
+
+uint32_t Dashboard::pendingSamples(uint8_t slot) const {
+    if (slot >= slotCount_ || slots_[slot].ring < 0) return 0;
+    return rings_[slots_[slot].ring].available();
+}
+
+// ─── Data rows ───────────────────────────────────────────────────────────────
+
+bool Dashboard::writeRow(char* buf, size_t bufLen, size_t& pos,
+                         const float* cells, const bool* live) const
+{
+    char scratch[16];
+
+    // The checksum covers the payload only and is folded in as each field
+    // is written, so the row is never walked a second time.
+    FrameCrc      crc(cfg_.checksum);
+    PayloadWriter out(cfg_.decoder, buf, bufLen, pos, crc);
+    const bool    packed = cfg_.decoder != Decoder::PlainText;
+
+    bool ok = putBytes(buf, bufLen, pos, "/*", 2);
+
+    // One field per dataset id; free ids and unkeyed datasets read "0".
+    for (uint8_t ordinal = 0; ordinal < fieldCount_; ++ordinal) {
+        const auto&   d     = datasets_[ordinal];
+        const uint8_t s     = d.cfg ? d.slot : kNone;
+        const bool    fresh = s != kNone && live[s];
+        const char*   held  = s != kNone ? slots_[s].shown() : "0";
+
+        if (packed) {
+            // Binary decoders get a state's index, not its name.
+            const bool labelled = s != kNone && slots_[s].label != kNone;
+            ok = ok && out.value(fresh    ? cells[s] :
+                                 labelled ? static_cast<float>(slots_[s].label) :
+                                            heldValue(held));
+        } else {
+            const char* val = fresh ? formatFloat(scratch, sizeof(scratch), cells[s]) : held;
+            if (ordinal > 0) ok = ok && out.text(",", 1);
+            ok = ok && out.text(val, strlen(val));
+        }
+    }
+    ok = ok && out.finish();
+
+    char sum[4];
+    ok = ok && putBytes(buf, bufLen, pos, "*/", 2);
+    ok = ok && putBytes(buf, bufLen, pos, sum, crc.write(sum));
+    return ok && putBytes(buf, bufLen, pos, "\r\n", 2);
+}
+
+void Dashboard::commitSample(uint8_t slot, float value) {
+    auto& s = slots_[slot];
+    if (!s.used()) return;   // removed while its samples were queued
+    s.label          = kNone;
+    s.window.pending = Pending::None;
+    formatFloat(s.text, s.width + 1u, value);   // width >= kNumericValueWidth
+}
+
+void Dashboard::storeText(uint8_t slot, const char* text) {
+    auto& s = slots_[slot];
+    for (uint8_t i = 0; i < s.labelCount; ++i) {
+        if (s.labels[i] && strcmp(s.labels[i], text) == 0) {
+            showLabel(slot, i);
+            return;
+        }
+    }
+
+    // Strings have no window to wait in: they land only when the slot is
+    // due.  Keep the value within the width maxFrameSize() reserved for it.
+    if (!isDue(slot)) return;
+    s.label          = kNone;
+    s.window.pending = Pending::None;
+    const size_t n = clipLength(text, s.width);
+    memmove(s.text, text, n);
+    s.text[n] = '\0';
+}
+
+// ─── serializeData() — "/*v1,…,vn*/" rows, draining FFT rings ────────────────
+
+size_t Dashboard::serializeData(char* buf, size_t bufLen) {
+    if (!buf || bufLen == 0) return 0;
+    syncValues();
+
+    // Snapshot each ring's backlog up front; samples pushed while we write
+    // wait for the next call instead of producing a ragged final row.
+    uint32_t backlog[kMaxFftSlots];
+    uint32_t rows   = 1;
+    bool     queued = false;
+    for (uint8_t r = 0; r < ringCount_; ++r) {
+        backlog[r] = ringSlots_[r] != kNone ? rings_[r].available() : 0;
+        if (backlog[r] > rows) rows = backlog[r];
+        queued = queued || backlog[r] > 0;
+    }
+
+    // A row with nothing due and no FFT samples would repeat the last one;
+    // this is where the scheduler saves bandwidth.
+    bool due = queued;
+    for (uint8_t s = 0; !due && s < slotCount_; ++s) due = isDue(s);
+    if (!due) {
+        buf[0] = '\0';
+        return 0;
+    }
+
+    float    cells[kMaxSlots];
+    bool     live[kMaxSlots] = {};
+    size_t   pos  = 0;
+    uint32_t done = 0;
+
+    for (; done < rows; ++done) {
+        // Once a ring runs dry, hold its last sample for the rest of the burst.
+        for (uint8_t r = 0; r < ringCount_; ++r) {
+            if (backlog[r] == 0) continue;
+            const uint32_t i = done < backlog[r] ? done : backlog[r] - 1;
+            cells[ringSlots_[r]] = rings_[r].peek(i);
+            live[ringSlots_[r]]  = true;
+        }
+
+        const size_t rowStart = pos;
+        if (!writeRow(buf, bufLen, pos, cells, live)) {
+            pos = rowStart;   // drop the partial row; its samples stay queued
+            break;
+        }
+    }
+
+    // Retire what was emitted and leave the last sample as the slot's value
+    // so full frames show the latest reading too.  The producer may be an
+    // ISR, so ring samples meet the alarm thresholds here, in order.
+    for (uint8_t r = 0; r < ringCount_; ++r) {
+        const uint32_t n = done < backlog[r] ? done : backlog[r];
+        if (n == 0) continue;
+        const uint8_t s = ringSlots_[r];
+        if (slots_[s].alarm.enabled) {
+            for (uint32_t i = 0; i < n; ++i) checkAlarm(s, rings_[r].peek(i));
+        }
+        commitSample(s, rings_[r].peek(n - 1));
+        rings_[r].consume(n);
+    }
+
+    if (done == 0) {
+#ifdef ARDUINO
+        Serial.printf("[ss] serializeData: bufLen(%u) too small for one row\n",
+                      static_cast<unsigned>(bufLen));
+#endif
+        return 0;
+    }
+
+    buf[pos] = '\0';
+    closeWindows();
+    priorityPending_ = false;
+    return pos;
+}
+
+// ─── Sample batches ──────────────────────────────────────────────────────────
+
+bool Dashboard::reserveBatch(uint16_t capacity) {
+    batch_.reset(new (std::nothrow) BatchSample[capacity]);
+    batchCap_ = batch_ ? capacity : 0;
+    batchLen_ = 0;
+    return batch_ != nullptr;
+}
+
+bool Dashboard::queueSample(uint8_t slot, float value, uint32_t timestampUs) {
+    if (!hasSlot(slot)) return false;
+
+    // Evaluated on arrival, so an alarm raises its priority frame before
+    // the batch goes out — and even when the batch has no room left.
+    if (slots_[slot].alarm.enabled) checkAlarm(slot, value);
+    if (batchLen_ >= batchCap_) return false;
+    batch_[batchLen_++] = {timestampUs, slot, value};
+    return true;
+}
+
+size_t Dashboard::serializeBatch(char* buf, size_t bufLen) {
+    if (!buf || bufLen == 0 || batchLen_ == 0) return 0;
+    syncValues();
+
+    float    cells[kMaxSlots];
+    bool     live[kMaxSlots] = {};
+    size_t   pos  = 0;
+    uint16_t used = 0;   // samples covered by fully written rows
+
+    while (used < batchLen_) {
+        // One row per distinct timestamp.  Slots without a sample at this
+        // instant hold whatever they last had in the batch.
+        const uint32_t ts  = batch_[used].timestampUs;
+        uint16_t       end = used;
+        while (end < batchLen_ && batch_[end].timestampUs == ts) {
+            cells[batch_[end].slot] = batch_[end].value;
+            live[batch_[end].slot]  = true;
+            ++end;
+        }
+
+        const size_t rowStart = pos;
+        if (!writeRow(buf, bufLen, pos, cells, live)) {
+            pos = rowStart;
+            break;
+        }
+        used = end;
+    }
+
+    if (used == 0) {
+#ifdef ARDUINO
+        Serial.printf("[ss] serializeBatch: bufLen(%u) too small for one row\n",
+                      static_cast<unsigned>(bufLen));
+#endif
+        return 0;
+    }
+
+    // Latest emitted value per slot becomes the dataset's current value.
+    for (uint16_t i = 0; i < used; ++i) live[batch_[i].slot] = false;
+    for (uint16_t i = used; i-- > 0;) {
+        const auto& b = batch_[i];
+        if (live[b.slot]) continue;
+        live[b.slot] = true;
+        commitSample(b.slot, b.value);
+    }
+
+    // Shift anything that did not fit to the front for the next call.
+    memmove(batch_.get(), batch_.get() + used,
+            (batchLen_ - used) * sizeof(BatchSample));
+    batchLen_ -= used;
+
+    buf[pos] = '\0';
+    closeWindows();
+    priorityPending_ = false;
+    return pos;
+}
+
+const char* Dashboard::iconToString(DashboardIcon icon) const {
+    return dashboardIconName(icon);
+}
+
+// ─── Footprint ───────────────────────────────────────────────────────────────
+
+Dashboard::Footprint Dashboard::footprint() const {
+    Footprint f = {sizeof(*this), 0, valuesLen_, 0, batchCap_ * sizeof(BatchSample), 0};
+#if SS_DASHBOARD_ARDUINOJSON
+    f.telemetry = telemetryPool_.stats().inUse + telemetryPool_.stats().cached;
+#endif
+    auto stored = [](const Segment& seg) { return seg.text ? seg.len : 0; };
+    for (uint8_t m = 0; m < 2; ++m) {
+        f.templates += stored(head_[m]) + stored(tail_[m]);
+        for (const auto& g : groups_) f.templates += stored(g.seg[m]);
+    }
+    for (uint8_t r = 0; r < ringCount_; ++r) f.rings += rings_[r].capacity() * sizeof(float);
+    return f;
 }
 
 // ─── estimateSize() ──────────────────────────────────────────────────────────
 
 size_t Dashboard::estimateSize() const {
-    // measureJson returns the compacted JSON length (no NUL).
-    // We add 4 for "/*" prefix + "*/" suffix, 2 for "\r\n", plus 1 for NUL.
-    return measureJson(doc_) + 7;
+    // Segments plus the current values, then 4 for "/*" prefix + "*/"
+    // suffix, 2 for "\r\n", 1 for NUL, plus the checksum bytes when one is
+    // configured.
+    return jsonLength(0, false) + 7 + checksumSize(cfg_.checksum);
+}
+
+size_t Dashboard::estimatePrettySize() const {
+    // "/*" + JSON + "\n*/" + checksum + "\r\n\r\n" + NUL.
+    return jsonLength(1, false) + 10 + checksumSize(cfg_.checksum);
 }
 
 // ─── serialize() — write "/*{…JSON…}*/" into buffer ──────────────────────────
 
-size_t Dashboard::serialize(char* buf, size_t bufLen, bool pretty) const {
+size_t Dashboard::serialize(char* buf, size_t bufLen, bool pretty) {
     if (!buf || bufLen < 6) {
 #ifdef ARDUINO
         Serial.printf("[ss] serialize: null buf or bufLen(%u) < 6\n",
@@ -240,50 +1569,68 @@ size_t Dashboard::serialize(char* buf, size_t bufLen, bool pretty) const {
     buf[0] = '/';
     buf[1] = '*';
 
-    // Leave room for: prefix(2) + suffix(2) + CRLF×2(4) + NUL(1) = 9 bytes
-    // overhead, plus one extra '\n' before '*/' in pretty mode.
-    // pretty-printed JSON is ~3–4× the compact size; callers must supply
-    // a buffer sized accordingly (estimateSize() * 4 is a safe bound).
-    if (bufLen < 9) {
+    // Overhead around the JSON: prefix(2) + suffix(2) + checksum + CRLF(2)
+    // + NUL(1), plus an extra '\n' and CRLF in pretty mode.
+    const uint8_t sumLen   = checksumSize(cfg_.checksum);
+    const size_t  overhead = (pretty ? 10u : 7u) + sumLen;
+    if (bufLen < overhead) {
 #ifdef ARDUINO
-        Serial.printf("[ss] serialize: bufLen(%u) < 9\n",
-                      static_cast<unsigned>(bufLen));
+        Serial.printf("[ss] serialize: bufLen(%u) < %u\n",
+                      static_cast<unsigned>(bufLen), static_cast<unsigned>(overhead));
 #endif
         return 0;
     }
-    const size_t room = bufLen - 9;
+    const size_t room = bufLen - overhead;
 
-    const size_t jsonLen = pretty
-        ? serializeJsonPretty(doc_, static_cast<void*>(buf + 2), room)
-        :         serializeJson(doc_, static_cast<void*>(buf + 2), room);
+    // Cached segments get the current values spliced into their holes;
+    // without a pretty cache, or while lazy templates are released, the
+    // writer renders the structure live.  Either way the payload is folded
+    // into the checksum as it is written, not in a second pass.
+    const uint8_t mode    = pretty ? 1 : 0;
+    size_t        jsonLen = 0;
+    bool          fits    = began();
+    FrameCrc      crc(cfg_.checksum);
+    projectServed_ = true;
+    syncValues();
+    if (fits && resident_ && (mode == 0 || prettyCached_)) {
+        jsonLen = jsonLength(mode, false);
+        fits    = jsonLen <= room;
+        if (fits) splice(mode, buf + 2, crc);
+    } else if (fits) {
+        FrameSink out{buf + 2, room, 0, true, datasets_, slots_, crc, 0};
+        ProjectWriter<FrameSink> w(out, mode ? prettyIndent_ : 0);
+        w.header(cfg_);
+        for (uint8_t g = 0; g < kMaxGroups; ++g) {
+            if (groups_[g].cfg && groups_[g].enabled) drawGroup(w, g);
+        }
+        w.footer();
+        out.fold();
+        jsonLen = out.pos;
+        fits    = out.ok;
+    }
 
-    if (jsonLen == 0) {
+    if (!fits) {
 #ifdef ARDUINO
-        Serial.printf("[ss] serialize: serializeJson returned 0 "
-                      "(doc empty? room=%u)\n", static_cast<unsigned>(room));
+        Serial.printf("[ss] serialize: JSON does not fit "
+                      "(room=%u) — size buf with maxFrameSize()\n",
+                      static_cast<unsigned>(room));
 #endif
         return 0;
     }
 
     // Write suffix: "\n*/\r\n\r\n" in pretty mode (delimiter on its own line);
     //               "*/\r\n"     in compact mode.
-    size_t pos = 2 + jsonLen;
-    const size_t need = pretty ? 8u : 5u;  // bytes needed after pos (incl. NUL)
-    if (pos + need > bufLen) {
-#ifdef ARDUINO
-        Serial.printf("[ss] serialize: suffix overflow "
-                      "(pos=%u need=%u bufLen=%u jsonLen=%u)\n",
-                      static_cast<unsigned>(pos),
-                      static_cast<unsigned>(need),
-                      static_cast<unsigned>(bufLen),
-                      static_cast<unsigned>(jsonLen));
-#endif
-        return 0;
+    // The checksum (if any) sits between "*/" and the CRLF.
+    size_t pos = 2 + jsonLen;   // room guarantees the suffix fits
+
+    if (pretty) {
+        buf[pos++] = '\n';  // newline before */ in pretty mode
+        crc.update("\n", 1);
     }
 
-    if (pretty) buf[pos++] = '\n';  // newline before */ in pretty mode
     buf[pos++] = '*';
     buf[pos++] = '/';
+    pos += crc.write(buf + pos);
     buf[pos++] = '\r';
     buf[pos++] = '\n';
     if (pretty) {
@@ -292,6 +1639,8 @@ size_t Dashboard::serialize(char* buf, size_t bufLen, bool pretty) const {
     }
     buf[pos]   = '\0';
 
+    closeWindows();
+    priorityPending_ = false;
     return pos;   // bytes written, excluding NUL
 }
 
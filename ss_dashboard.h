@@ -2,34 +2,178 @@
  * @file ss_dashboard.h
  * @brief Serial Studio dashboard JSON generator.
  *
- * Builds and maintains a Serial Studio–compatible JSON document from a
- * compile-time configuration (ss::DashboardCfg).  On each telemetry update
- * the caller provides a JsonDocument containing the latest sensor readings;
- * the Dashboard class patches the "value" field of every dataset and
- * serialises the result, wrapped in the required  / *  …  * /  delimiters,
- * ready for WebSocket broadcast.
+ * Builds a Serial Studio–compatible project JSON from a compile-time
+ * configuration (ss::DashboardCfg).  begin() renders the static structure
+ * once into a template with a hole for every dataset "value"; each frame
+ * copies the template and patches the current values in, wrapped in the
+ * required  / *  …  * /  delimiters, ready for WebSocket broadcast.
  *
- * The library depends only on ArduinoJson — it is intentionally decoupled
- * from FrameBuilder and any other project-specific types.
+ * Values arrive through the typed setters (setValue() / setText()) or, in
+ * the full build profile, from a JsonDocument via update() — see
+ * ss_profile.h.  The library is intentionally decoupled from FrameBuilder
+ * and any other project-specific types.
  */
 
 #pragma once
 
+#include "ss_profile.h"
+
+#if SS_DASHBOARD_ARDUINOJSON
 #include <ArduinoJson.h>
+#endif
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
 #include "ss_dashboard_config.h"
 #include "ss_icons.h"
-
+#include "ss_keys.h"
 
 
 namespace ss {
 
+// ─── Sample ring ─────────────────────────────────────────────────────────────
+
+/**
+ * Single-producer / single-consumer lock-free ring of float samples.
+ *
+ * The producer (a sampling ISR or task) calls push(); the Dashboard is the
+ * only consumer.  Capacity is a power of two and head/tail are free-running
+ * counters, so neither side ever takes a lock or disables interrupts.
+ */
+class SampleRing {
+public:
+    /**
+     * Allocate storage for at least @p minCapacity samples (rounded up to a
+     * power of two).  Not ISR-safe; call before the producer starts.
+     *
+     * @return false if the allocation failed.
+     */
+    bool init(uint16_t minCapacity);
+
+    /** Producer side.  @return false (sample dropped) if the ring is full. */
+    bool push(float v) {
+        const uint32_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) > mask_) return false;
+        buf_[head & mask_] = v;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** Consumer side: samples ready to be read. */
+    uint32_t available() const {
+        return head_.load(std::memory_order_acquire) -
+               tail_.load(std::memory_order_relaxed);
+    }
+
+    /** Consumer side: read the @p i-th pending sample without removing it. */
+    float peek(uint32_t i) const {
+        return buf_[(tail_.load(std::memory_order_relaxed) + i) & mask_];
+    }
+
+    /** Consumer side: drop @p n samples that have been emitted. */
+    void consume(uint32_t n) {
+        tail_.store(tail_.load(std::memory_order_relaxed) + n,
+                    std::memory_order_release);
+    }
+
+    uint32_t capacity() const { return buf_ ? mask_ + 1 : 0; }
+
+private:
+    std::unique_ptr<float[]> buf_;
+    uint32_t                 mask_ = 0;
+    std::atomic<uint32_t>    head_{0};
+    std::atomic<uint32_t>    tail_{0};
+};
+
+// ─── Alarms ──────────────────────────────────────────────────────────────────
+
+/** Device-side alarm state of a value slot. */
+enum class AlarmState : uint8_t {
+    Normal,
+    Low,            ///< Value at or below alarmLow
+    High            ///< Value at or above alarmHigh
+};
+
+/** Passed to the alarm callback on every state change. */
+struct AlarmEvent {
+    uint8_t     slot;           ///< Slot index (see Dashboard::findSlot())
+    const char* telemetryKey;   ///< Borrowed from the config; nullptr for a field-only dataset
+    AlarmState  state;          ///< New state
+    AlarmState  previous;       ///< State before this sample
+    float       value;          ///< Sample that caused the transition
+};
+
+/**
+ * Alarm callback.  Runs synchronously inside update() / setValue() /
+ * queueSample(), and inside serializeData() for samples drained from an
+ * FFT ring.
+ */
+using AlarmCallback = void (*)(void* ctx, const AlarmEvent& ev);
+
+#if SS_DASHBOARD_ARDUINOJSON
+// ─── Telemetry pool ──────────────────────────────────────────────────────────
+
+/**
+ * ArduinoJson allocator that never gives memory back on its own.  Blocks a
+ * document frees are kept and handed out again to the next request they
+ * fit, so a document that is cleared and refilled every tick stops touching
+ * the heap once it has seen its largest tick.  A block outgrown by
+ * reallocate() is freed rather than cached.  release() returns the cached
+ * blocks to the heap.
+ */
+class TelemetryPool : public ArduinoJson::Allocator {
+public:
+    /** Usage figures, in bytes of block capacity. */
+    struct Stats {
+        size_t   inUse;         ///< Held by the document right now
+        size_t   peak;          ///< Highest inUse so far
+        size_t   cached;        ///< Freed and waiting for reuse
+        uint32_t heapAllocs;    ///< Blocks ever taken from the heap
+        uint32_t reuses;        ///< Requests served from the cache
+    };
+
+    TelemetryPool() = default;
+    TelemetryPool(const TelemetryPool&)            = delete;
+    TelemetryPool& operator=(const TelemetryPool&) = delete;
+    ~TelemetryPool() { release(); }
+
+    void* allocate(size_t size) override;
+    void  deallocate(void* ptr) override;
+    void* reallocate(void* ptr, size_t newSize) override;
 
+    /** Free every cached block.  Blocks in use are unaffected. */
+    void release();
 
+    const Stats& stats() const { return stats_; }
+
+private:
+    struct Block {
+        size_t capacity;
+        Block* next;            ///< Free-list link while cached
+    };
+
+    Block* free_  = nullptr;    ///< Cached blocks, any order
+    Stats  stats_ = {};
+};
+#endif
+
+// ─── Dashboard ───────────────────────────────────────────────────────────────
 
 class Dashboard {
 public:
-    // Maximum number of dataset→telemetry mappings.
-    static constexpr uint8_t kMaxSlots = 48;
+    // Table sizes; see ss_profile.h to change them.
+
+    // Maximum number of datasets with a value slot.
+    static constexpr uint8_t kMaxSlots = SS_MAX_SLOTS;
+
+    // Maximum number of FFT datasets with a sample ring.
+    static constexpr uint8_t kMaxFftSlots = SS_MAX_FFT_SLOTS;
+
+    // Maximum number of groups / datasets in the layout, counting both the
+    // config and runtime additions.
+    static constexpr uint8_t kMaxGroups   = SS_MAX_GROUPS;
+    static constexpr uint8_t kMaxDatasets = SS_MAX_DATASETS;
 
     /**
      * Construct a Dashboard from the supplied configuration.
@@ -39,15 +183,94 @@ public:
     explicit Dashboard(const DashboardCfg& cfg);
 
     /**
-     * Build the initial JSON document from the configuration.
-     * Call once during setup().
+     * Build the layout and project template from the configuration.
+     * Call once during setup(); calling it again discards runtime layout
+     * changes.
      *
-     * @return true on success; false if the config is invalid.
+     * @param cache  Optional snapshot from saveTemplates().  When it was
+     *               taken with the same configHash(), the rendered templates
+     *               are copied from it instead of being rebuilt; otherwise
+     *               it is ignored.
+     * @param len    Size of @p cache in bytes.
+     * @return true on success; false if the config exceeds kMaxGroups /
+     *         kMaxDatasets or the template cannot be allocated.
      */
-    bool begin();
+    bool begin(const uint8_t* cache = nullptr, size_t len = 0);
+
+    // ── Runtime layout ───────────────────────────────────────────────────────
+    //
+    // Group and dataset ids are positions in the layout: after begin(), the
+    // config's groups are 0…groupCount-1 and its datasets are numbered
+    // across all groups in config order, so dataset id + 1 is the Serial
+    // Studio "index" and the field position in a data row.  Ids never move:
+    // removing one leaves a gap (its data-row field reads "0") and the next
+    // addition takes the lowest free id.  Each change re-renders only the
+    // affected group's template segment and bumps layoutVersion(); send the
+    // project frame again afterwards so Serial Studio picks it up.
+    //
+    // Added configs are borrowed, like the DashboardCfg, and must outlive
+    // their place in the layout.
+
+    /**
+     * Append a group together with its datasets.
+     *
+     * @return Group id, or -1 if the layout is full or allocation failed.
+     */
+    int addGroup(const GroupCfg& group);
 
+    /**
+     * Add a dataset to @p group.  A telemetryKey or a struct field gets a
+     * value slot (see findSlot()); an FFT dataset also gets a free sample
+     * ring.
+     *
+     * @return Dataset id, or -1 if the group does not exist, the layout is
+     *         full or allocation failed.
+     */
+    int addDataset(uint8_t group, const DatasetCfg& dataset);
+
+    /** Remove a group and every dataset in it. */
+    bool removeGroup(uint8_t group);
+
+    /** Remove a dataset; its slot becomes invalid and may be reused. */
+    bool removeDataset(uint8_t dataset);
+
+    /** Hide or show a group without touching its datasets' slots. */
+    bool setGroupEnabled(uint8_t group, bool enabled);
+
+    /**
+     * Hide or show a dataset.  A hidden dataset keeps its id, slot and value
+     * (and its data-row field) but is left out of the project JSON.
+     */
+    bool setDatasetEnabled(uint8_t dataset, bool enabled);
+
+    /** Incremented by begin() and by every layout change. */
+    uint32_t layoutVersion() const { return layoutVersion_; }
+
+    /**
+     * Structural hash of the project as Serial Studio sees it: the compact
+     * template of every shown group, without values.  Unlike
+     * layoutVersion() it is stable across reboots and instances — equal
+     * layouts hash equal — so a transport can tell whether a reconnecting
+     * client already has this project (see ProjectHandshake).
+     */
+    uint32_t layoutHash() const { return layoutHash_; }
+
+    /**
+     * Update every dataset bound to a member of struct @p source (see
+     * DatasetCfg::field and SS_FIELD()) from @p data.  Each value is read
+     * straight from its offset and goes through aggregation, alarms and
+     * refresh scheduling like setValue(); no JSON is built or parsed, so
+     * this works in both build profiles.
+     *
+     * @param data    Start of the struct; may be unaligned.
+     * @param source  The id the datasets' FieldRef was built with.
+     */
+    void update(const void* data, uint8_t source = 0);
+
+#if SS_DASHBOARD_ARDUINOJSON
     /**
      * Update every dataset "value" field from the latest telemetry.
+     * Full profile only (ss_dashboard_json.cpp).
      *
      * @param telemetry  Nested JSON produced by FrameBuilder::fillJson().
      *                   Keys are dot-separated paths matching the DatasetCfg
@@ -55,6 +278,152 @@ public:
      */
     void update(const JsonDocument& telemetry);
 
+    /**
+     * The Dashboard's own telemetry document, cleared and ready to fill:
+     *
+     * @code
+     *   JsonDocument& telemetry = dashboard.beginTelemetry();
+     *   telemetry["temp"] = readTemp();
+     *   dashboard.update(telemetry);
+     * @endcode
+     *
+     * Its memory comes from a TelemetryPool, so clearing keeps the capacity
+     * and steady-state ticks allocate nothing.  ingest() parses into the
+     * same document.  The reference stays valid for the Dashboard's
+     * lifetime; the contents only until the next beginTelemetry() or
+     * ingest().
+     */
+    JsonDocument& beginTelemetry();
+
+    /** Pool usage of the telemetry document (peak size, heap traffic). */
+    const TelemetryPool::Stats& telemetryStats() const { return telemetryPool_.stats(); }
+
+    /** Return the pooled telemetry memory to the heap; contents are lost. */
+    void releaseTelemetry();
+
+    /** Wire encoding of the raw telemetry passed to ingest(). */
+    enum class Encoding : uint8_t { Json, MsgPack };
+
+    /**
+     * Parse raw telemetry bytes (e.g. a line from a sensor hub UART) and
+     * update every slot from them, like update().  The parser runs with a
+     * DeserializationOption::Filter holding just the slots' telemetryKey
+     * paths — built in begin() and again after a layout change — so fields
+     * no dataset uses are skipped without being stored.
+     *
+     * @return false if the input does not parse; no slot is touched then.
+     */
+    bool ingest(const void* data, size_t len, Encoding encoding = Encoding::Json);
+#endif
+
+    /**
+     * Feed one numeric sample to a slot without going through a
+     * JsonDocument.  Honours the dataset's aggregation mode exactly like
+     * update().
+     *
+     * @param slot   Index returned by findSlot().
+     * @param value  Sample value.
+     */
+    void setValue(uint8_t slot, float value);
+
+    /**
+     * Set a slot's value to a string, bypassing aggregation and alarms —
+     * the typed counterpart of a string leaf in update().  The text is
+     * truncated to the dataset's valueWidth.  Dropped when the slot is not
+     * due this frame, unless it names one of the dataset's labels.
+     *
+     * @param slot  Index returned by findSlot().
+     * @param text  NUL-terminated value text.
+     */
+    void setText(uint8_t slot, const char* text);
+
+    /**
+     * Typed setter: the handler is picked at compile time from @p T, with
+     * no kind check at run time.  Floating-point values go through
+     * setValue(), integers and enums are printed exactly (or shown as their
+     * DatasetCfg::labels entry; aggregation and alarms still see them as
+     * float), bool is 0 / 1 and strings go through setText().
+     *
+     * @code
+     *   dashboard.set(heapSlot, ESP.getFreeHeap());   // "1234567", not "1.23457e+06"
+     *   dashboard.set(stateSlot, "Cooling");
+     * @endcode
+     */
+    template <typename T>
+    void set(uint8_t slot, T value) {
+        if (!hasSlot(slot)) return;
+        if constexpr (std::is_same<T, bool>::value) {
+            feed(slot, value ? 1.0f : 0.0f);
+        } else if constexpr (std::is_enum<T>::value) {
+            feedInt(slot, static_cast<int64_t>(value));   // labelled by DatasetCfg::labels
+        } else if constexpr (std::is_integral<T>::value && std::is_signed<T>::value) {
+            feedInt(slot, static_cast<int64_t>(value));
+        } else if constexpr (std::is_integral<T>::value) {
+            feedUInt(slot, static_cast<uint64_t>(value));
+        } else if constexpr (std::is_floating_point<T>::value) {
+            feed(slot, static_cast<float>(value));
+        } else {
+            static_assert(std::is_convertible<T, const char*>::value,
+                          "Dashboard::set: unsupported value type");
+            if (value) storeText(slot, value);
+        }
+    }
+
+    /**
+     * Decide which slots are refreshed for the coming frame.  Call once per
+     * frame, before update() / setValue().
+     *
+     * Critical datasets are always due.  Normal datasets are due every
+     * updateEvery-th frame (staggered by slot so equal divisors don't land on
+     * the same frame) and no faster than maxRateHz.  Eligible Housekeeping
+     * datasets additionally share setHousekeepingBudget() refreshes per
+     * frame, handed out round-robin.
+     *
+     * Numeric samples for a slot that is not due still reach its alarm
+     * check and its aggregation window, which stays open until the slot is
+     * next due; only the value text waits.  Strings for such a slot are
+     * dropped.  An alarm transition makes its slot due for the current
+     * frame, and serializeData() writes no row while nothing is due.
+     *
+     * Until beginFrame() is first called every slot is due on every frame.
+     *
+     * @param nowMs  Current time in milliseconds (e.g. millis()).
+     * @return       Number of slots due this frame.
+     */
+    uint8_t beginFrame(uint32_t nowMs);
+
+    /** Maximum Housekeeping slots refreshed per frame.  Default: 1. */
+    void setHousekeepingBudget(uint8_t slotsPerFrame) { hkBudget_ = slotsPerFrame; }
+
+    /** True if @p slot is refreshed in the current frame. */
+    bool isDue(uint8_t slot) const {
+        return hasSlot(slot) && ((dueMask_ >> slot) & 1u);
+    }
+
+    /** Reset every Aggregate::PeakHold slot so the next sample starts a new peak. */
+    void clearPeaks();
+
+    /**
+     * Register a callback for alarm transitions.  Datasets with
+     * alarmEnabled are evaluated on the device against alarmLow / alarmHigh
+     * for every numeric sample, with alarmHysteresis applied on the way out.
+     *
+     * @param cb   Callback, or nullptr to unregister.
+     * @param ctx  Opaque pointer forwarded to @p cb.
+     */
+    void onAlarm(AlarmCallback cb, void* ctx = nullptr);
+
+    /** Current alarm state of @p slot. */
+    AlarmState alarmState(uint8_t slot) const;
+
+    /**
+     * True when a dataset with alarmImmediate changed alarm state since the
+     * last emitted frame.  Transmit loops should check this and send a frame
+     * straight away instead of waiting for the next interval.  Cleared by
+     * serialize(), serializeData() and serializeBatch().
+     */
+    bool priorityFramePending() const { return priorityPending_; }
+
     /**
      * Serialise the dashboard JSON, wrapped in  / *  …  * /  delimiters.
      *
@@ -63,17 +432,216 @@ public:
      * @param pretty  If true, use indented (pretty-printed) JSON instead of
      *                compact JSON.  Pretty output is ~3–4× larger; ensure
      *                @p buf is sized accordingly.  Default: false.
+     * Emitting a frame publishes the due slots' pending values, closes
+     * their aggregation windows and clears priorityFramePending(), so this
+     * is not const.  estimateSize() measures the same frame without any of
+     * that.
+     *
      * @return        Bytes written (excluding NUL), or 0 on failure.
      */
-    size_t serialize(char* buf, size_t bufLen, bool pretty = false) const;
+    size_t serialize(char* buf, size_t bufLen, bool pretty = false);
+
+    /**
+     * Cache the pretty-printed template so serialize(pretty = true) patches
+     * values into it like the compact one, instead of re-rendering the whole
+     * structure on every call.  Costs RAM roughly the size of one pretty
+     * frame; meant for debug consoles.  May be called before or after
+     * begin().
+     *
+     * @param indent  Spaces per nesting level.  0 frees the cache and goes
+     *                back to rendering live at the default 2 spaces.
+     * @return        false if the template could not be allocated (pretty
+     *                output then stays live at @p indent).
+     */
+    bool cachePretty(uint8_t indent = 2);
+
+    // ── Template cache ───────────────────────────────────────────────────────
+    //
+    // Rendering the templates is most of begin()'s work.  A node that wakes
+    // from deep sleep or restarts after a watchdog reset can keep a snapshot
+    // in RTC memory or flash and pass it back to begin(cache, len), which
+    // copies the templates instead of rendering them.  The snapshot is keyed
+    // by configHash(), so a changed config (or library template format)
+    // simply renders afresh.
+
+    /** Hash of the DashboardCfg and the template format, set by begin(). */
+    uint32_t configHash() const { return configHash_; }
+
+    /**
+     * Bytes saveTemplates() writes; 0 before begin() or after a runtime
+     * layout change, since only the layout begin() builds is cached.
+     */
+    size_t templateCacheSize() const;
+
+    /**
+     * Snapshot the rendered templates (compact, and pretty if cached) and
+     * every value's position in them.
+     *
+     * @return Bytes written, or 0 if templateCacheSize() is 0 or exceeds
+     *         @p cap.
+     */
+    size_t saveTemplates(uint8_t* buf, size_t cap) const;
+
+    /** True if the last begin() took its templates from a snapshot. */
+    bool templatesRestored() const { return restored_; }
+
+    // ── Lazy templates ───────────────────────────────────────────────────────
+    //
+    // A headless unit may go hours without a consumer.  In lazy mode begin()
+    // only measures the templates (so the size queries still work) and the
+    // RAM they take is spent once a consumer shows up.  Until then,
+    // serialize() renders the project live from the layout, exactly as the
+    // uncached pretty path does.
+
+    /**
+     * Enable lazy templates.  Takes effect at the next begin().
+     *
+     * With @p lazy, templates are built by acquireTemplates() (call it on
+     * client connect) or by the first beginFrame() after a project frame
+     * was serialised.  With @p idleReleaseMs > 0, beginFrame() frees them
+     * again once no project frame has been serialised for that long.
+     * Values, slots and layout are never released.
+     */
+    void setLazy(bool lazy, uint32_t idleReleaseMs = 0);
+
+    /**
+     * Build the templates now.  No-op if they are resident.
+     *
+     * @return false before begin() or if they cannot be allocated; output
+     *         then stays live.
+     */
+    bool acquireTemplates();
+
+    /** Free the templates; serialize() renders live until they are rebuilt. */
+    void releaseTemplates();
+
+    /** True while the templates are held in RAM. */
+    bool templatesResident() const { return resident_; }
+
+    /**
+     * Look up the value slot bound to a telemetry key.
+     *
+     * @return Slot index for pushSample(), or -1 if no dataset uses @p key.
+     */
+    int findSlot(const char* telemetryKey) const;
+
+    /**
+     * Queue one raw sample for an FFT dataset.  Lock-free and safe to call
+     * from the sampling ISR or task while another task serialises.
+     *
+     * Only datasets with fft = true and a value slot get a ring (sized to
+     * fftSamples, rounded up to a power of two).  Alarm thresholds are
+     * checked against every sample as serializeData() drains it, not here,
+     * so the callback never runs in the producer's context.
+     *
+     * @param slot   Index returned by findSlot().
+     * @param value  Sample value.
+     * @return       false if the slot has no ring or the ring is full.
+     */
+    bool pushSample(uint8_t slot, float value);
+
+    /** Samples queued for @p slot and not yet emitted. */
+    uint32_t pendingSamples(uint8_t slot) const;
+
+    /**
+     * Serialise the current values as Serial Studio data frames
+     * ( / * v1,v2,…,vn * /  + CRLF), one field per dataset in index order.
+     *
+     * Pending FFT samples are drained as a burst of consecutive rows — one
+     * row per queued sample — so the FFT sees the real sampling rate rather
+     * than one value per frame.  Non-FFT fields repeat their current value
+     * on every row.  Rows that do not fit in @p buf stay queued for the next
+     * call.
+     *
+     * @param buf     Destination buffer.
+     * @param bufLen  Size of @p buf in bytes.
+     * @return        Bytes written (excluding NUL), or 0 if not even one row
+     *                fits — or if no slot is due and no FFT sample is
+     *                queued, since the row would only repeat the last one.
+     */
+    size_t serializeData(char* buf, size_t bufLen);
+
+    /**
+     * Allocate the sample batch buffer used by queueSample().  Call once
+     * (e.g. in setup()); queueSample() never allocates.
+     *
+     * @param capacity  Maximum number of queued samples across all slots.
+     * @return          false if the allocation failed.
+     */
+    bool reserveBatch(uint16_t capacity);
+
+    /**
+     * Queue one timestamped sample for any value slot.  Samples sharing a
+     * timestamp end up in the same data row.  Queue them in timestamp order;
+     * not ISR-safe — call from the task that calls serializeBatch().  The
+     * sample meets the slot's alarm thresholds straight away.
+     *
+     * @param slot         Index returned by findSlot().
+     * @param value        Sample value.
+     * @param timestampUs  Sample time (e.g. micros()).
+     * @return             false if the slot is invalid or the batch is full.
+     */
+    bool queueSample(uint8_t slot, float value, uint32_t timestampUs);
+
+    /** Samples currently queued in the batch buffer. */
+    uint16_t batchedSamples() const { return batchLen_; }
+
+    /**
+     * Emit the queued batch as consecutive data frames in one buffer, so the
+     * whole batch goes out in a single write.  Each distinct timestamp
+     * becomes one row; slots without a sample at that instant hold their
+     * previous value.  Rows that do not fit stay queued.
+     *
+     * @return Bytes written (excluding NUL), or 0 if nothing was emitted.
+     */
+    size_t serializeBatch(char* buf, size_t bufLen);
 
     /**
      * Estimate the minimum buffer size needed by serialize(compact).
-     * For pretty mode allocate at least estimateSize() * 4.
-     * Includes the two-byte prefix, suffix, CRLF, and NUL overhead.
+     * Includes the two-byte prefix, suffix, CRLF, checksum and NUL overhead.
+     * Exact for the current values only; see maxFrameSize() for a bound.
      */
     size_t estimateSize() const;
 
+    /**
+     * Exact buffer size serialize(pretty = true) needs for the current
+     * values, including delimiters, CRLFs, checksum and NUL.
+     */
+    size_t estimatePrettySize() const;
+
+    /**
+     * Worst-case buffer size for serialize(), fixed at begin() and updated
+     * by layout changes.  Every dataset with a value slot is counted at
+     * its valueWidth (numeric datasets at kNumericValueWidth), and update()
+     * truncates strings to that width, so a buffer of this size never makes
+     * serialize() fail for the current layout.
+     */
+    size_t maxFrameSize(bool pretty = false) const {
+        return pretty ? maxPrettySize_ : maxCompactSize_;
+    }
+
+    /**
+     * Worst-case buffer size for one serializeData() / serializeBatch() row.
+     * A burst of n rows needs n * maxRowSize() (only one NUL is written, so
+     * this is slightly generous).
+     */
+    size_t maxRowSize() const { return maxRowSize_; }
+
+    /** Heap and object RAM held by the Dashboard, in bytes. */
+    struct Footprint {
+        size_t object;      ///< sizeof(Dashboard), slot table included
+        size_t templates;   ///< Cached project template text, compact and pretty
+        size_t values;      ///< Per-slot value text
+        size_t rings;       ///< FFT sample rings
+        size_t batch;       ///< queueSample() batch buffer
+        size_t telemetry;   ///< Pooled telemetry document, in use and cached
+
+        size_t total() const { return object + templates + values + rings + batch + telemetry; }
+    };
+
+    /** RAM used by this instance; call after begin() / reserveBatch(). */
+    Footprint footprint() const;
+
     /**
      * Convert an Icon enum value to a string.
      *
@@ -84,94 +652,328 @@ public:
 
 private:
     const DashboardCfg& cfg_;
-    JsonDocument        doc_;
 
-    // ── Pre-computed value-slot table ────────────────────────────────────────
+    static constexpr uint8_t kNone = 0xFF;   ///< "No entry" in the tables below
+
+    // ── Layout ───────────────────────────────────────────────────────────────
     //
-    // Built once in begin().  Each slot records the telemetry key and the
-    // (group, dataset) position inside doc_ so that update() can patch
-    // values without re-walking the config.
+    // One entry per group / dataset id.  A group's datasets form a list in
+    // ascending id order, which is also their order in the project JSON.
+
+    /** Rendered JSON text; len and hash are kept even when text is not stored. */
+    struct Segment {
+        std::unique_ptr<char[]> text;
+        size_t                  len  = 0;
+        uint32_t                hash = 0;   ///< FNV-1a of the rendered text
+    };
+
+    struct GroupEntry {
+        const GroupCfg* cfg;        ///< nullptr = free id
+        bool            enabled;
+        uint8_t         first;      ///< First dataset id, or kNone
+        Segment         seg[2];     ///< [0] compact, [1] pretty (text only if cached)
+    };
+
+    struct DatasetEntry {
+        const DatasetCfg* cfg;      ///< nullptr = free id
+        uint8_t           group;
+        uint8_t           next;     ///< Next dataset of the group, or kNone
+        uint8_t           slot;     ///< Value slot, or kNone
+        bool              enabled;
+    };
+
+    GroupEntry   groups_[kMaxGroups];
+    DatasetEntry datasets_[kMaxDatasets];
+    uint8_t      fieldCount_    = 0;   ///< Highest dataset id in use + 1
+    uint32_t     layoutVersion_ = 0;
+    uint32_t     layoutHash_    = 0;
+
+    // Everything before the first group and after the last: [0] compact,
+    // [1] pretty.  Group segments sit between, joined by ','.
+    Segment head_[2];
+    Segment tail_[2];
+
+    uint8_t prettyIndent_ = 2;
+    bool    prettyCached_ = false;
+
+    uint32_t configHash_   = 0;
+    uint32_t beginVersion_ = 0;       ///< layoutVersion_ as begin() left it
+    bool     restored_     = false;
+    bool     begun_        = false;
+
+    // Segment text is stored only while resident_; lengths always are.
+    bool         resident_      = false;
+    bool         lazy_          = false;
+    uint32_t     idleReleaseMs_ = 0;
+    uint32_t     lastServedMs_  = 0;
+    bool         projectServed_ = false;   ///< serialize() ran since the last beginFrame()
+
+    // ── Value slots ──────────────────────────────────────────────────────────
+    //
+    // One per dataset with a telemetryKey or a struct field, so that update()
+    // can patch values without re-walking the layout.  Freed slots have an
+    // ordinal of kNone and are reused by the next addition.
+    //
+    // Samples always reach the alarm check and the window; the text only
+    // follows when the slot is due (see publish()).
+
+    /** What a slot's next publish() writes into its text. */
+    enum class Pending : uint8_t {
+        None,
+        Window,                     ///< The aggregation window's result
+        Integer,                    ///< Window::exact, printed exactly
+        Label                       ///< labels[Window::exact]
+    };
 
     struct ValueSlot {
-        const char* telemetryKey;   ///< Dotted path (borrowed from config)
-        uint8_t     groupIdx;
-        uint8_t     datasetIdx;
+        const char* telemetryKey;   ///< Dotted path (borrowed from config), or nullptr
+        uint8_t     ordinal;        ///< Dataset id: 0-based field position in a data row; kNone = free
+        int8_t      ring;           ///< Index into rings_, or -1
+        Aggregate   aggregate;      ///< Copied from DatasetCfg
+        uint8_t     width;          ///< Longest value text, in escaped JSON bytes
+        char*       text;           ///< Current value (width + 1 bytes in values_)
+        uint32_t    hole[2];        ///< Value offset in its group's segments
+
+        struct Window {
+            uint64_t exact;         ///< Pending integer magnitude or label index
+            uint32_t count;         ///< Samples folded in so far
+            float    acc;           ///< Running min / max / sum / Σx² / peak
+            Pending  pending;       ///< Value waiting for the slot to be due
+            bool     negative;      ///< Sign of a pending integer
+            bool     closed;        ///< Emitted; the next sample opens a new window
+        };
+        Window      window;         ///< Published and closed by the emitters
+
+        struct Alarm {
+            bool       enabled;
+            bool       immediate;   ///< Request a priority frame on transitions
+            AlarmState state;
+            float      low;
+            float      high;
+            float      hysteresis;
+        } alarm;
+
+        struct Schedule {
+            Priority priority;
+            uint8_t  every;         ///< Refresh divisor (≥ 1)
+            uint16_t minPeriodMs;   ///< 1000 / maxRateHz, or 0
+            uint32_t lastMs;        ///< Time the slot was last due
+            bool     ran;           ///< lastMs is valid
+        } sched;
+
+        FieldRef  field;            ///< Copied from DatasetCfg
+        ValueKind kind;             ///< Declared kind, or inferred; Auto until known
+
+        const char* const* labels;  ///< Borrowed from DatasetCfg, or nullptr
+        uint8_t            labelCount;
+        uint8_t            label;   ///< Label shown instead of text, or kNone
+
+        /** True if the slot belongs to a dataset. */
+        bool used() const { return ordinal != kNone; }
+
+        /** What the slot shows: its label, or its own value text. */
+        const char* shown() const { return label != kNone ? labels[label] : text; }
     };
 
-    ValueSlot slots_[kMaxSlots];
-    uint8_t   slotCount_ = 0;
+    ValueSlot               slots_[kMaxSlots];
+    uint8_t                 slotCount_ = 0;   ///< Highest slot in use + 1
+    std::unique_ptr<char[]> values_;          ///< Backing store for ValueSlot::text
+    size_t                  valuesLen_ = 0;
+
+    // ProjectWriter sinks (ss_dashboard.cpp).
+    struct TemplateSink;
+    struct FrameSink;
+
+    // Worst-case buffer sizes for the current layout.
+    size_t maxCompactSize_ = 0;
+    size_t maxPrettySize_  = 0;
+    size_t maxRowSize_     = 0;
+
+    static_assert(kMaxSlots > 0 && kMaxSlots <= 64, "dueMask_ holds one bit per slot");
+    static_assert(kMaxGroups > 0 && kMaxGroups < kNone, "group ids are uint8_t, kNone excluded");
+    static_assert(kMaxDatasets > 0 && kMaxDatasets < kNone, "dataset ids are uint8_t, kNone excluded");
+    static_assert(kMaxFftSlots > 0 && kMaxFftSlots <= 127, "ValueSlot::ring is an int8_t");
+
+    // Refresh schedule (see beginFrame()).
+    uint64_t dueMask_    = ~0ull;
+    uint32_t schedFrame_ = 0;
+    uint8_t  hkBudget_   = 1;
+    uint8_t  hkCursor_   = 0;     ///< Round-robin start for Housekeeping slots
+
+    // Alarm edge reporting.
+    AlarmCallback alarmCb_         = nullptr;
+    void*         alarmCtx_        = nullptr;
+    bool          priorityPending_ = false;
+
+    // FFT sample rings.  A ring freed by removeDataset() is reused.
+    SampleRing rings_[kMaxFftSlots];
+    uint8_t    ringSlots_[kMaxFftSlots];   ///< Owning slot of each ring, or kNone
+    uint8_t    ringCount_ = 0;
+
+    // Timestamped sample batch, allocated once by reserveBatch().
+    struct BatchSample {
+        uint32_t timestampUs;
+        uint8_t  slot;
+        float    value;
+    };
+
+    std::unique_ptr<BatchSample[]> batch_;
+    uint16_t                       batchCap_ = 0;
+    uint16_t                       batchLen_ = 0;
 
     // ── Internal helpers ─────────────────────────────────────────────────────
 
-    void buildActions();
-    void buildGroups();
+    /** Take the lowest free group id for @p g.  Datasets are added separately. */
+    int  linkGroup(const GroupCfg& g);
+
+    /** Take the lowest free dataset id in @p group, with a slot if keyed. */
+    int  linkDataset(uint8_t group, const DatasetCfg& ds);
+    void unlinkDataset(uint8_t id);
+
+    /** Unlink every dataset of @p g and free the group id. */
+    void dropGroup(uint8_t g);
+
+    bool began() const { return begun_; }
+
+    /** True if @p slot is a value slot in use. */
+    bool hasSlot(uint8_t slot) const {
+        return slot < slotCount_ && slots_[slot].used();
+    }
+
+    /**
+     * Resize values_ for the slots in use, keeping each slot's text; new
+     * slots start at "0".
+     */
+    bool allocValues();
+
+    /**
+     * Render one segment.  Text is stored while resident_, for compact or
+     * for pretty when cached; otherwise only the length is kept.
+     */
+    template <typename Draw>
+    bool renderSegment(Segment& seg, uint8_t mode, Draw draw);
+
+    bool renderGroup(uint8_t g, uint8_t mode);
+    bool renderFrame(uint8_t mode);      ///< Head, tail and every group
+
+    /**
+     * Take the templates from a saveTemplates() snapshot.
+     *
+     * @return Modes restored: 0 (unusable), 1 (compact only — pretty needs
+     *         another indent or its text was not saved) or 2.
+     */
+    uint8_t restoreTemplates(const uint8_t* cache, size_t len);
+
+    /** Render the pretty segments, falling back to live output on failure. */
+    void renderPretty();
+
+    /** Write group @p g's object through @p w. */
+    template <typename Writer>
+    void drawGroup(Writer& w, uint8_t g) const;
+
+    /** Re-render @p g in both modes and refresh the size bounds. */
+    bool relayout(uint8_t g);
 
-    static const char* widgetStr(WidgetType w);
-    static const char* groupWidgetStr(GroupWidget w);
+    /** Recompute the worst-case buffer sizes and layoutHash_ for the current layout. */
+    void updateBounds();
+
+    /** Project JSON length in @p mode, at the current or the widest values. */
+    size_t jsonLength(uint8_t mode, bool worst) const;
+
+    /**
+     * Write the project JSON in @p mode to @p out from the cached segments,
+     * folding each piece into @p crc as it is copied.
+     */
+    size_t splice(uint8_t mode, char* out, FrameCrc& crc) const;
+
+    /** Pretty tail bytes to skip when no group is shown (an empty "[]"). */
+    size_t tailSkip(uint8_t mode) const;
 
     /**
-     * Resolve a dotted key path (e.g. "temperature.k") inside a JsonDocument.
+     * Append one  / * v1,…,vn * /  + CRLF row at @p pos.  Slot s contributes
+     * cells[s] when live[s] is set, otherwise its current value text.  In
+     * Hexadecimal / Base64 mode the values are packed float32 instead.
      *
-     * If the leaf is numeric the value is formatted into @p scratch and a
-     * pointer to that buffer is returned.  If it is already a string the
-     * pointer into the JsonDocument is returned directly.
+     * @return false if the row did not fit (pos is then undefined).
+     */
+    bool writeRow(char* buf, size_t bufLen, size_t& pos,
+                  const float* cells, const bool* live) const;
+
+    /** Evaluate the slot's alarm thresholds against one raw sample. */
+    void checkAlarm(uint8_t slot, float x);
+
+    /**
+     * Fold one numeric sample into the slot's aggregation window.  O(1) and
+     * text-free: the window is formatted once, when a frame needs it.
+     */
+    void feed(uint8_t slot, float x);
+
+    /**
+     * Text the slot shows once published, without publishing it: a pending
+     * number is rendered into @p scratch (width + 1 bytes), a pending label
+     * or a settled value is returned as is.  Keeps the sizing calls const.
+     */
+    const char* preview(uint8_t slot, char* scratch) const;
+
+    /** Write the slot's pending value into its text, if the slot is due. */
+    void publish(uint8_t slot);
+
+    /** publish() every slot; run before value text is written. */
+    void syncValues();
+
+    /** A frame went out: the next sample of each due window starts a new one. */
+    void closeWindows();
+
+    /**
+     * Integer samples.  With Aggregate::Last the text is the exact integer;
+     * otherwise (or when it would not fit the slot) they fold like feed().
+     */
+    void feedInt(uint8_t slot, int64_t x);
+    void feedUInt(uint8_t slot, uint64_t x);
+
+    /** Shared tail of feedInt() / feedUInt(). */
+    void feedInteger(uint8_t slot, uint64_t magnitude, bool negative);
+
+    /** Show label @p index by reference; alarms see the index. */
+    void showLabel(uint8_t slot, uint8_t index);
+
+    /** Store a drained sample as the slot's current "value", replacing any window. */
+    void commitSample(uint8_t slot, float value);
+
+    /** Copy @p text into the slot, clipped to its width, if the slot is due. */
+    void storeText(uint8_t slot, const char* text);
+
+#if SS_DASHBOARD_ARDUINOJSON
+    /** Rebuild filter_ from the telemetryKey of every slot in use. */
+    void buildFilter();
+
+    TelemetryPool telemetryPool_;         ///< Declared first: outlives telemetry_
+    JsonDocument  telemetry_;             ///< See beginTelemetry()
+    JsonDocument  filter_;                ///< {"a":{"b":true},…} for ingest()
+    uint32_t     filterVersion_ = 0;      ///< layoutVersion_ filter_ was built for
+
+    /**
+     * Walk a dotted key path (e.g. "temperature.k") inside a JsonDocument.
      *
-     * @return Pointer to value string, or nullptr if the path does not exist.
+     * @return The leaf node, or a null variant if the path does not exist.
      */
-    static const char* resolveKey(const JsonDocument& doc,
-                                  const char* dottedKey,
-                                  char* scratch,
-                                  size_t scratchLen);
-};
+    static JsonVariantConst resolveNode(const JsonDocument& doc,
+                                        const char* dottedKey);
+
+    /** Kind of a JSON leaf, for ValueKind::Auto slots.  Auto for null / containers. */
+    static ValueKind inferKind(JsonVariantConst node);
 
+    /**
+     * Per-kind JSON handlers, one specialization each (ss_dashboard_json.cpp).
+     *
+     * @return false if @p node is not of kind @p K; the slot is untouched.
+     */
+    template <ValueKind K>
+    bool applyNode(uint8_t slot, JsonVariantConst node);
 
-//------------------------------------------------------------------------------
-// Standard keys used in Serial Studio JSON files
-//------------------------------------------------------------------------------
-
-namespace Keys
-{
-inline constexpr auto EOL = "eol";
-inline constexpr auto Icon = "icon";
-inline constexpr auto Title = "title";
-inline constexpr auto TxData = "txData";
-inline constexpr auto Binary = "binary";
-inline constexpr auto TimerMode = "timerMode";
-inline constexpr auto TimerInterval = "timerIntervalMs";
-inline constexpr auto AutoExecute = "autoExecuteOnConnect";
-
-inline constexpr auto FFT = "fft";
-inline constexpr auto LED = "led";
-inline constexpr auto Log = "log";
-inline constexpr auto Min = "min";
-inline constexpr auto Max = "max";
-inline constexpr auto Graph = "graph";
-inline constexpr auto Index = "index";
-inline constexpr auto XAxis = "xAxis";
-inline constexpr auto Alarm = "alarm";
-inline constexpr auto Units = "units";
-inline constexpr auto Value = "value";
-inline constexpr auto Widget = "widget";
-inline constexpr auto FFTMin = "fftMin";
-inline constexpr auto FFTMax = "fftMax";
-inline constexpr auto PltMin = "plotMin";
-inline constexpr auto PltMax = "plotMax";
-inline constexpr auto LedHigh = "ledHigh";
-inline constexpr auto WgtMin = "widgetMin";
-inline constexpr auto WgtMax = "widgetMax";
-inline constexpr auto AlarmLow = "alarmLow";
-inline constexpr auto AlarmHigh = "alarmHigh";
-inline constexpr auto FFTSamples = "fftSamples";
-inline constexpr auto Overview = "overviewDisplay";
-inline constexpr auto AlarmEnabled = "alarmEnabled";
-inline constexpr auto FFTSamplingRate = "fftSamplingRate";
-
-inline constexpr auto Groups = "groups";
-inline constexpr auto Actions = "actions";
-inline constexpr auto Datasets = "datasets";
-
-inline constexpr auto DashboardLayout = "dashboardLayout";
-inline constexpr auto ActiveGroupId = "activeGroupId";
-} // namespace Keys
+    /** applyNode<@p kind>; false for Auto. */
+    bool applyKind(ValueKind kind, uint8_t slot, JsonVariantConst node);
+#endif
+};
 
 } // namespace ss
@@ -19,10 +19,11 @@
  */
 
 #pragma once
-#include <map>
-#include <string>
+#include <cstddef>
 #include <cstdint>
+#include <type_traits>
 #include "ss_icons.h"
+#include "ss_checksum.h"
 
 namespace ss {
 
@@ -47,8 +48,149 @@ enum class GroupWidget : uint8_t {
     Accelerometer   ///< 3-axis accelerometer view
 };
 
+// ─── Aggregation modes ───────────────────────────────────────────────────────
+
+/**
+ * How a dataset folds multiple samples between emitted frames into one value.
+ * Every mode is O(1) per sample; the window restarts after each frame.
+ */
+enum class Aggregate : uint8_t {
+    Last,           ///< Most recent sample (no aggregation)
+    Min,            ///< Smallest sample in the window
+    Max,            ///< Largest sample in the window
+    Mean,           ///< Arithmetic mean of the window
+    Rms,            ///< Root-mean-square of the window
+    PeakHold        ///< Largest-magnitude sample; held across frames until clearPeaks()
+};
+
+// ─── Value kinds ─────────────────────────────────────────────────────────────
+
+/**
+ * What a dataset's value is.  update() dispatches each slot to one handler
+ * for its kind instead of probing every JSON type per value.  Auto settles
+ * on a kind from the first value seen (or from the struct member's type,
+ * see DatasetCfg::field) and changes it only if the telemetry does.
+ */
+enum class ValueKind : uint8_t {
+    Auto,           ///< Inferred once from the data
+    Float,          ///< Number, printed like "%.6g"
+    Int,            ///< Signed integer, printed exactly
+    UInt,           ///< Unsigned integer, printed exactly
+    Bool,           ///< 0 / 1
+    String,         ///< Text, clipped to valueWidth
+    Enum            ///< Index into DatasetCfg::labels (or one of the labels), shown as the label
+};
+
+// ─── Data frame encoding ─────────────────────────────────────────────────────
+
+/**
+ * Serial Studio decoder applied to data frames (the project "decoder" field).
+ * PlainText rows are comma-separated text; the other modes carry every
+ * dataset as a packed little-endian float32, encoded as hex or Base64.
+ */
+enum class Decoder : uint8_t {
+    PlainText   = 0,    ///< "v1,v2,…" text
+    Hexadecimal = 1,    ///< Packed float32 values, two hex digits per byte
+    Base64      = 2     ///< Packed float32 values, Base64 encoded
+};
+
+// ─── Update scheduling ───────────────────────────────────────────────────────
+
+/**
+ * Scheduling class of a dataset, used by Dashboard::beginFrame().
+ */
+enum class Priority : uint8_t {
+    Critical,       ///< Refreshed on every frame, ignoring rate limits
+    Normal,         ///< Refreshed per updateEvery / maxRateHz
+    Housekeeping    ///< Like Normal, but shares a per-frame budget round-robin
+};
+
+// ─── Struct fields ───────────────────────────────────────────────────────────
+
+/** Scalar type of a struct member bound to a dataset. */
+enum class FieldType : uint8_t {
+    None,           ///< Not bound to a struct
+    Bool,
+    U8,
+    I8,
+    U16,
+    I16,
+    U32,
+    I32,
+    F32,
+    F64
+};
+
+/**
+ * Location of a dataset's value inside a telemetry struct: which struct
+ * (@p source, an application-chosen id) and where in it.  Build it with
+ * SS_FIELD() rather than by hand so the offset and type follow the struct.
+ */
+struct FieldRef {
+    uint8_t   source = 0;
+    uint16_t  offset = 0;                ///< offsetof() the member
+    FieldType type   = FieldType::None;
+};
+
+namespace detail {
+
+// Integers are matched by size and signedness rather than by name, so int
+// and long both work whichever of them the toolchain's int32_t is.
+template <typename T, bool = std::is_enum<T>::value>
+struct FieldTypeOf {
+    static constexpr bool kInt = std::is_integral<T>::value && !std::is_same<T, bool>::value;
+    static constexpr bool kSigned = std::is_signed<T>::value;
+    static constexpr FieldType value =
+        std::is_same<T, bool>::value   ? FieldType::Bool :
+        std::is_same<T, float>::value  ? FieldType::F32  :
+        std::is_same<T, double>::value ? FieldType::F64  :
+        !kInt                          ? FieldType::None :
+        sizeof(T) == 1 ? (kSigned ? FieldType::I8  : FieldType::U8)  :
+        sizeof(T) == 2 ? (kSigned ? FieldType::I16 : FieldType::U16) :
+        sizeof(T) == 4 ? (kSigned ? FieldType::I32 : FieldType::U32) :
+                         FieldType::None;
+};
+
+// Enums are read through their underlying integer type.
+template <typename T>
+struct FieldTypeOf<T, true> : FieldTypeOf<typename std::underlying_type<T>::type> {};
+
+} // namespace detail
+
+/** FieldType of a C++ scalar type; FieldType::None if it has none. */
+template <typename T>
+constexpr FieldType fieldTypeOf() {
+    return detail::FieldTypeOf<typename std::remove_cv<T>::type>::value;
+}
+
+namespace detail {
+
+template <typename T>
+constexpr FieldRef fieldRef(uint8_t source, size_t offset) {
+    static_assert(fieldTypeOf<T>() != FieldType::None,
+                  "SS_FIELD: member is not a bool, integer, enum, float or double");
+    return {source, static_cast<uint16_t>(offset), fieldTypeOf<T>()};
+}
+
+} // namespace detail
+
+/**
+ * FieldRef for @p Struct::member, e.g.
+ * @code
+ *   { .title = "RSSI", .telemetryKey = "radio.rssi",
+ *     .field = SS_FIELD(0, RadioFrame, rssi) }
+ * @endcode
+ * The struct may be packed; members are read with memcpy.
+ */
+#define SS_FIELD(source, Struct, member)                                      \
+    (::ss::detail::fieldRef<decltype(Struct::member)>(                        \
+        (source), offsetof(Struct, member)))
+
 // ─── Dataset configuration ───────────────────────────────────────────────────
 
+/// Widest text "%.6g" produces for a float, e.g. "-1.17549e-38".
+inline constexpr uint8_t kNumericValueWidth = 12;
+
 /**
  * Configuration for a single dataset (data channel) in the dashboard.
  *
@@ -77,6 +219,17 @@ struct DatasetCfg {
     uint16_t    fftSamples      = 256;
     uint16_t    fftSamplingRate = 100;
     int8_t      xAxis           = -1;
+    Aggregate   aggregate       = Aggregate::Last;  ///< Sample folding between frames
+    float       alarmHysteresis = 0.0f;   ///< Band an alarm must clear before it resets
+    bool        alarmImmediate  = false;  ///< Request a priority frame on alarm transitions
+    Priority    priority        = Priority::Normal;
+    uint8_t     updateEvery     = 1;      ///< Refresh every Nth frame (0 or 1 = every frame)
+    uint16_t    maxRateHz       = 0;      ///< Refresh at most this often (0 = unlimited)
+    uint8_t     valueWidth      = 0;      ///< Longest string value in bytes (numbers always reserve kNumericValueWidth); longer strings are truncated
+    FieldRef    field           = {};     ///< Struct member fed by Dashboard::update(const void*, source)
+    ValueKind   kind            = ValueKind::Auto;  ///< Value type; Auto infers it once
+    const char* const* labels   = nullptr;  ///< State names: integer i is shown as labels[i]
+    uint8_t     labelCount      = 0;
 };
 
 // ─── Group configuration ─────────────────────────────────────────────────────
@@ -108,6 +261,9 @@ struct DashboardCfg {
     uint8_t           groupCount  = 0;
     const ActionCfg*  actions     = nullptr;
     uint8_t           actionCount = 0;
+    Checksum          checksum    = Checksum::None;  ///< Appended after every frame's end delimiter
+    Decoder           decoder     = Decoder::PlainText;  ///< Data frame encoding
+    bool              omitDefaults = false;  ///< Leave out project fields equal to Serial Studio's defaults
 };
 
 
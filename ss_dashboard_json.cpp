@@ -0,0 +1,285 @@
+/**
+ * @file ss_dashboard_json.cpp
+ * @brief Dashboard::update(const JsonDocument&), ingest() and the pooled
+ *        telemetry document — full build profile only.
+ *
+ * Everything that touches ArduinoJson lives here, so the minimal profile
+ * (SS_DASHBOARD_ARDUINOJSON=0) compiles this file to nothing.
+ */
+
+#include "ss_dashboard.h"
+
+#if SS_DASHBOARD_ARDUINOJSON
+
+#include <cstring>
+#include <cstdlib>
+#include <cstddef>
+
+namespace ss {
+
+// ─── TelemetryPool ───────────────────────────────────────────────────────────
+
+namespace {
+
+// Block header, padded so the payload keeps malloc()'s alignment.
+constexpr size_t kBlockHeader =
+    (sizeof(size_t) + sizeof(void*) + alignof(std::max_align_t) - 1) /
+    alignof(std::max_align_t) * alignof(std::max_align_t);
+
+} // namespace
+
+void* TelemetryPool::allocate(size_t size) {
+    // Smallest cached block that fits; a document refilled with the same
+    // shape every tick then gets the same blocks back every tick.
+    Block** best = nullptr;
+    for (Block** p = &free_; *p; p = &(*p)->next) {
+        if ((*p)->capacity >= size && (!best || (*p)->capacity < (*best)->capacity)) {
+            best = p;
+        }
+    }
+
+    Block* b = nullptr;
+    if (best) {
+        b      = *best;
+        *best  = b->next;
+        stats_.cached -= b->capacity;
+        ++stats_.reuses;
+    } else {
+        b = static_cast<Block*>(malloc(kBlockHeader + size));
+        if (!b) return nullptr;
+        b->capacity = size;
+        ++stats_.heapAllocs;
+    }
+
+    stats_.inUse += b->capacity;
+    if (stats_.inUse > stats_.peak) stats_.peak = stats_.inUse;
+    return reinterpret_cast<uint8_t*>(b) + kBlockHeader;
+}
+
+void TelemetryPool::deallocate(void* ptr) {
+    if (!ptr) return;
+    auto* b = reinterpret_cast<Block*>(static_cast<uint8_t*>(ptr) - kBlockHeader);
+    stats_.inUse  -= b->capacity;
+    stats_.cached += b->capacity;
+    b->next = free_;
+    free_   = b;
+}
+
+void* TelemetryPool::reallocate(void* ptr, size_t newSize) {
+    if (!ptr) return allocate(newSize);
+    auto* b = reinterpret_cast<Block*>(static_cast<uint8_t*>(ptr) - kBlockHeader);
+    if (newSize <= b->capacity) return ptr;   // shrinking keeps the block
+
+    void* grown = allocate(newSize);
+    if (!grown) return nullptr;
+    memcpy(grown, ptr, b->capacity);
+
+    // The outgrown block goes back to the heap, not the cache: the next
+    // document of the same shape asks for the larger size, so caching it
+    // would only lengthen the free list on every growth step.
+    stats_.inUse -= b->capacity;
+    free(b);
+    return grown;
+}
+
+void TelemetryPool::release() {
+    while (free_) {
+        Block* next = free_->next;
+        free(free_);
+        free_ = next;
+    }
+    stats_.cached = 0;
+}
+
+JsonDocument& Dashboard::beginTelemetry() {
+    telemetry_.clear();
+    return telemetry_;
+}
+
+void Dashboard::releaseTelemetry() {
+    telemetry_.clear();
+    telemetryPool_.release();
+}
+
+// ─── resolveNode() — navigate dotted path in JSON ────────────────────────────
+
+JsonVariantConst Dashboard::resolveNode(const JsonDocument& doc,
+                                        const char* dottedKey)
+{
+    if (!dottedKey || dottedKey[0] == '\0') return JsonVariantConst();
+
+    // Copy key so we can tokenise it (strtok-style, but without modifying
+    // the original).  Max depth = 4 levels should be more than enough.
+    char keyBuf[64];
+    const size_t keyLen = strlen(dottedKey);
+    if (keyLen >= sizeof(keyBuf)) return JsonVariantConst();
+    memcpy(keyBuf, dottedKey, keyLen + 1);
+
+    // Walk the JSON tree one segment at a time.
+    JsonVariantConst node = doc.as<JsonVariantConst>();
+
+    char* savePtr = nullptr;
+    char* token   = strtok_r(keyBuf, ".", &savePtr);
+    while (token) {
+        if (!node.is<JsonObjectConst>()) return JsonVariantConst();
+        node = node[token];
+        if (node.isNull()) return JsonVariantConst();
+        token = strtok_r(nullptr, ".", &savePtr);
+    }
+    return node;
+}
+
+// ─── Per-kind value handlers ─────────────────────────────────────────────────
+
+ValueKind Dashboard::inferKind(JsonVariantConst node) {
+    if (node.is<const char*>()) return ValueKind::String;
+    if (node.is<bool>())        return ValueKind::Bool;
+    if (node.is<int64_t>())     return ValueKind::Int;
+    if (node.is<uint64_t>())    return ValueKind::UInt;
+    if (node.is<float>())       return ValueKind::Float;
+    return ValueKind::Auto;
+}
+
+template <>
+bool Dashboard::applyNode<ValueKind::Float>(uint8_t slot, JsonVariantConst node) {
+    if (!node.is<float>()) return false;
+    feed(slot, node.as<float>());
+    return true;
+}
+
+template <>
+bool Dashboard::applyNode<ValueKind::Int>(uint8_t slot, JsonVariantConst node) {
+    if (!node.is<int64_t>()) return false;
+    feedInt(slot, node.as<int64_t>());
+    return true;
+}
+
+template <>
+bool Dashboard::applyNode<ValueKind::UInt>(uint8_t slot, JsonVariantConst node) {
+    if (!node.is<uint64_t>()) return false;
+    feedUInt(slot, node.as<uint64_t>());
+    return true;
+}
+
+template <>
+bool Dashboard::applyNode<ValueKind::Bool>(uint8_t slot, JsonVariantConst node) {
+    if (!node.is<bool>()) return false;
+    feed(slot, node.as<bool>() ? 1.0f : 0.0f);
+    return true;
+}
+
+template <>
+bool Dashboard::applyNode<ValueKind::String>(uint8_t slot, JsonVariantConst node) {
+    if (!node.is<const char*>()) return false;
+    storeText(slot, node.as<const char*>());
+    return true;
+}
+
+template <>
+bool Dashboard::applyNode<ValueKind::Enum>(uint8_t slot, JsonVariantConst node) {
+    if (node.is<int64_t>()) {
+        feedInt(slot, node.as<int64_t>());
+        return true;
+    }
+    if (!node.is<const char*>()) return false;
+    storeText(slot, node.as<const char*>());   // matched against the labels
+    return true;
+}
+
+bool Dashboard::applyKind(ValueKind kind, uint8_t slot, JsonVariantConst node) {
+    switch (kind) {
+        case ValueKind::Float:  return applyNode<ValueKind::Float>(slot, node);
+        case ValueKind::Int:    return applyNode<ValueKind::Int>(slot, node);
+        case ValueKind::UInt:   return applyNode<ValueKind::UInt>(slot, node);
+        case ValueKind::Bool:   return applyNode<ValueKind::Bool>(slot, node);
+        case ValueKind::String: return applyNode<ValueKind::String>(slot, node);
+        case ValueKind::Enum:   return applyNode<ValueKind::Enum>(slot, node);
+        case ValueKind::Auto:   break;
+    }
+    return false;
+}
+
+// ─── update() — patch all "value" fields from telemetry ──────────────────────
+
+void Dashboard::update(const JsonDocument& telemetry) {
+    for (uint8_t s = 0; s < slotCount_; ++s) {
+        if (!hasSlot(s) || !slots_[s].telemetryKey) continue;
+        auto& slot = slots_[s];
+
+        const JsonVariantConst node = resolveNode(telemetry, slot.telemetryKey);
+        if (node.isNull()) continue;
+
+        // Hot path: one type check, in the handler for the slot's kind.
+        if (applyKind(slot.kind, s, node)) continue;
+
+        // First value of an Auto slot, or one of another type.  An inferred
+        // kind follows the telemetry; a declared one is kept for next time.
+        const ValueKind seen = inferKind(node);
+        if (seen == ValueKind::Auto) continue;
+        if (datasets_[slot.ordinal].cfg->kind == ValueKind::Auto && !slot.labels) slot.kind = seen;
+        applyKind(seen, s, node);
+    }
+}
+
+// ─── ingest() — filtered parse of raw JSON / MessagePack ─────────────────────
+
+namespace {
+
+// Mark one tokenised path in a filter: interior segments become objects, the
+// leaf becomes true.  A path that already ends in true keeps its whole
+// subtree, so a key that is a prefix of another one wins.
+void addFilterPath(JsonObject parent, char* token, char** savePtr) {
+    if (!token || parent[token].is<bool>()) return;
+    char* next = strtok_r(nullptr, ".", savePtr);
+    if (!next) {
+        parent[token] = true;
+        return;
+    }
+    addFilterPath(parent[token].is<JsonObject>() ? parent[token].as<JsonObject>()
+                                                 : parent[token].to<JsonObject>(),
+                  next, savePtr);
+}
+
+} // namespace
+
+void Dashboard::buildFilter() {
+    filter_.clear();
+    JsonObject root = filter_.to<JsonObject>();
+
+    for (uint8_t s = 0; s < slotCount_; ++s) {
+        const char* key = slots_[s].telemetryKey;
+        if (!key || key[0] == '\0') continue;
+
+        char keyBuf[64];
+        const size_t keyLen = strlen(key);
+        if (keyLen >= sizeof(keyBuf)) continue;   // resolveNode() skips it too
+        memcpy(keyBuf, key, keyLen + 1);
+
+        char* savePtr = nullptr;
+        addFilterPath(root, strtok_r(keyBuf, ".", &savePtr), &savePtr);
+    }
+    filterVersion_ = layoutVersion_;
+}
+
+bool Dashboard::ingest(const void* data, size_t len, Encoding encoding) {
+    if (!data) return false;
+    if (filterVersion_ != layoutVersion_) buildFilter();
+
+    const DeserializationOption::Filter filter(filter_.as<JsonVariantConst>());
+    const DeserializationError err = encoding == Encoding::MsgPack
+        ? deserializeMsgPack(telemetry_, static_cast<const uint8_t*>(data), len, filter)
+        : deserializeJson(telemetry_, static_cast<const char*>(data), len, filter);
+    if (err) {
+#ifdef ARDUINO
+        Serial.printf("[ss] ingest: %s\n", err.c_str());
+#endif
+        return false;
+    }
+
+    update(telemetry_);
+    return true;
+}
+
+} // namespace ss
+
+#endif // SS_DASHBOARD_ARDUINOJSON
@@ -1,8 +1,12 @@
 #pragma once
 
+#include <cstdint>
+#include "ss_profile.h"
+
+#if SS_DASHBOARD_ARDUINOJSON
 #include <map>
 #include <string>
-#include <cstdint>
+#endif
 
 namespace ss {
   enum class DashboardIcon : uint8_t {
@@ -22,7 +26,29 @@ namespace ss {
     NoWidget
 };
 
-const std::map<DashboardIcon, std::string> DashboardIconMap = {
+/** Serial Studio icon file for @p icon. */
+constexpr const char* dashboardIconName(DashboardIcon icon) {
+    switch (icon) {
+        case DashboardIcon::DataGrid:       return "datagrid.svg";
+        case DashboardIcon::MultiPlot:      return "multiplot.svg";
+        case DashboardIcon::Accelerometer:  return "accelerometer.svg";
+        case DashboardIcon::Gyroscope:      return "gyroscope.svg";
+        case DashboardIcon::GPS:            return "gps.svg";
+        case DashboardIcon::FFT:            return "fft.svg";
+        case DashboardIcon::LED:            return "led.svg";
+        case DashboardIcon::Plot:           return "plot.svg";
+        case DashboardIcon::Bar:            return "bar.svg";
+        case DashboardIcon::Gauge:          return "gauge.svg";
+        case DashboardIcon::Compass:        return "compass.svg";
+        case DashboardIcon::Terminal:       return "terminal.svg";
+        case DashboardIcon::Plot3D:         return "plot3d.svg";
+        case DashboardIcon::NoWidget:       return "group.svg";
+        default:                            return nullptr;
+    }
+}
+
+#if SS_DASHBOARD_ARDUINOJSON
+inline const std::map<DashboardIcon, std::string> DashboardIconMap = {
     {DashboardIcon::DataGrid, "datagrid.svg"},
     {DashboardIcon::MultiPlot, "multiplot.svg"},
     {DashboardIcon::Accelerometer, "accelerometer.svg"},
@@ -38,6 +64,7 @@ const std::map<DashboardIcon, std::string> DashboardIconMap = {
     {DashboardIcon::Plot3D, "plot3d.svg"},
     {DashboardIcon::NoWidget, "group.svg"}
 };
+#endif
 
 enum class ActionIcon : uint8_t {
     Abscissa,
@@ -150,7 +177,8 @@ enum class ActionIcon : uint8_t {
     ZoomOut,
 };
 
-const std::map<ActionIcon, std::string> ActionIconMap = {
+#if SS_DASHBOARD_ARDUINOJSON
+inline const std::map<ActionIcon, std::string> ActionIconMap = {
     {ActionIcon::Abscissa, "Abscissa"}  ,
     {ActionIcon::Accuracy, "Accuracy"},
     {ActionIcon::AddProperties, "Add properties"},
@@ -260,4 +288,5 @@ const std::map<ActionIcon, std::string> ActionIconMap = {
     {ActionIcon::ZoomIn, "Zoom In"},
     {ActionIcon::ZoomOut, "Zoom Out"},
 };
+#endif
 }
\ No newline at end of file
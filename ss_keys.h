@@ -0,0 +1,62 @@
+/**
+ * @file ss_keys.h
+ * @brief Serial Studio project-file key names.
+ *
+ * Shared by the runtime Dashboard and the compile-time ProjectWriter so both
+ * spell every key the same way.
+ */
+
+#pragma once
+
+namespace ss {
+
+//------------------------------------------------------------------------------
+// Standard keys used in Serial Studio JSON files
+//------------------------------------------------------------------------------
+
+namespace Keys
+{
+inline constexpr auto EOL = "eol";
+inline constexpr auto Icon = "icon";
+inline constexpr auto Title = "title";
+inline constexpr auto TxData = "txData";
+inline constexpr auto Binary = "binary";
+inline constexpr auto TimerMode = "timerMode";
+inline constexpr auto TimerInterval = "timerIntervalMs";
+inline constexpr auto AutoExecute = "autoExecuteOnConnect";
+
+inline constexpr auto FFT = "fft";
+inline constexpr auto LED = "led";
+inline constexpr auto Log = "log";
+inline constexpr auto Min = "min";
+inline constexpr auto Max = "max";
+inline constexpr auto Graph = "graph";
+inline constexpr auto Index = "index";
+inline constexpr auto XAxis = "xAxis";
+inline constexpr auto Alarm = "alarm";
+inline constexpr auto Units = "units";
+inline constexpr auto Value = "value";
+inline constexpr auto Widget = "widget";
+inline constexpr auto FFTMin = "fftMin";
+inline constexpr auto FFTMax = "fftMax";
+inline constexpr auto PltMin = "plotMin";
+inline constexpr auto PltMax = "plotMax";
+inline constexpr auto LedHigh = "ledHigh";
+inline constexpr auto WgtMin = "widgetMin";
+inline constexpr auto WgtMax = "widgetMax";
+inline constexpr auto AlarmLow = "alarmLow";
+inline constexpr auto AlarmHigh = "alarmHigh";
+inline constexpr auto FFTSamples = "fftSamples";
+inline constexpr auto Overview = "overviewDisplay";
+inline constexpr auto AlarmEnabled = "alarmEnabled";
+inline constexpr auto FFTSamplingRate = "fftSamplingRate";
+
+inline constexpr auto Groups = "groups";
+inline constexpr auto Actions = "actions";
+inline constexpr auto Datasets = "datasets";
+
+inline constexpr auto DashboardLayout = "dashboardLayout";
+inline constexpr auto ActiveGroupId = "activeGroupId";
+} // namespace Keys
+
+} // namespace ss
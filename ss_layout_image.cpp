@@ -0,0 +1,629 @@
+/**
+ * @file ss_layout_image.cpp
+ * @brief Relocatable dashboard layout images — implementation.
+ *
+ * Image layout (all sections at their natural alignment):
+ *
+ *   Header | DashboardCfg | GroupCfg[] | DatasetCfg[] | ActionCfg[] | strings
+ *
+ * Pointer fields hold byte offsets from the start of the image (0 = null)
+ * until adopt() turns them back into pointers; save() reverses that on the
+ * way out, so the bytes on flash are always in offset form.
+ */
+
+#include "ss_layout_image.h"
+#include "ss_checksum.h"
+#include "ss_project_writer.h"
+#include <cstring>
+#include <limits>
+#include <new>
+#include <utility>
+
+#if SS_DASHBOARD_ARDUINOJSON
+#include <ArduinoJson.h>
+#endif
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+
+namespace ss {
+
+namespace {
+
+struct Header {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved;
+    uint16_t structSize[4];   ///< DashboardCfg, GroupCfg, DatasetCfg, ActionCfg
+    uint32_t size;            ///< Whole image, header included
+    uint32_t crc;             ///< CRC-32 of everything after the header
+    uint32_t sourceSize;
+    uint32_t sourceCrc;
+    uint16_t datasetCount;    ///< Across all groups
+    uint8_t  groupCount;
+    uint8_t  actionCount;
+};
+
+/** Byte offsets of the image sections, fixed by the counts. */
+struct Sections {
+    size_t root, groups, datasets, actions, pool;
+};
+
+constexpr size_t alignUp(size_t n, size_t a) {
+    return (n + a - 1) / a * a;
+}
+
+Sections sections(size_t groups, size_t datasets, size_t actions) {
+    Sections s{};
+    s.root     = alignUp(sizeof(Header), alignof(DashboardCfg));
+    s.groups   = alignUp(s.root + sizeof(DashboardCfg), alignof(GroupCfg));
+    s.datasets = alignUp(s.groups + groups * sizeof(GroupCfg), alignof(DatasetCfg));
+    s.actions  = alignUp(s.datasets + datasets * sizeof(DatasetCfg), alignof(ActionCfg));
+    s.pool     = s.actions + actions * sizeof(ActionCfg);
+    return s;
+}
+
+uint32_t crc32(const uint8_t* data, size_t len) {
+    FrameCrc crc(Checksum::Crc32);
+    crc.update(data, len);
+    return crc.value();
+}
+
+/** Pointer → image offset (save()). */
+template <typename T>
+void toOffset(const T*& p, const uint8_t* base) {
+    if (p) p = reinterpret_cast<const T*>(reinterpret_cast<const uint8_t*>(p) - base);
+}
+
+/** Image offset → pointer (adopt()); false if outside [lo, hi). */
+template <typename T>
+bool toPointer(const T*& p, const uint8_t* base, size_t lo, size_t hi) {
+    const auto off = reinterpret_cast<uintptr_t>(p);
+    if (off == 0) return true;
+    if (off < lo || off >= hi) return false;
+    p = reinterpret_cast<const T*>(base + off);
+    return true;
+}
+
+/** Streams the image, rebasing each struct on a copy so the RAM image is untouched. */
+class ImageWriter {
+public:
+    ImageWriter(LayoutImage::SinkFn sink, void* ctx, const uint8_t* base)
+        : sink_(sink), ctx_(ctx), base_(base) {}
+
+    /** Copy the bytes up to @p off verbatim. */
+    void upTo(size_t off) {
+        write(base_ + pos_, off - pos_);
+        pos_ = off;
+    }
+
+    /** Write the T at the current position after @p rebase has fixed its copy. */
+    template <typename T, typename Rebase>
+    void object(Rebase rebase) {
+        alignas(T) uint8_t tmp[sizeof(T)];
+        memcpy(tmp, base_ + pos_, sizeof(T));
+        rebase(*reinterpret_cast<T*>(tmp));
+        write(tmp, sizeof(T));
+        pos_ += sizeof(T);
+    }
+
+    bool ok() const { return ok_; }
+
+private:
+    void write(const uint8_t* p, size_t n) {
+        if (ok_ && n) ok_ = sink_(ctx_, p, n) == n;
+    }
+
+    LayoutImage::SinkFn sink_;
+    void*               ctx_;
+    const uint8_t*      base_;
+    size_t              pos_ = 0;
+    bool                ok_  = true;
+};
+
+#if SS_DASHBOARD_ARDUINOJSON
+
+// ─── Project JSON → image ────────────────────────────────────────────────────
+
+constexpr const char* kAggregateNames[] = {
+    "last", "min", "max", "mean", "rms", "peakHold"
+};
+constexpr const char* kPriorityNames[] = { "critical", "normal", "housekeeping" };
+constexpr const char* kKindNames[] = {
+    "auto", "float", "int", "uint", "bool", "string", "enum"
+};
+static_assert(sizeof(kKindNames) / sizeof(kKindNames[0]) ==
+              static_cast<size_t>(ValueKind::Enum) + 1, "one name per ValueKind");
+
+/** Index of @p name in @p names, or -1. */
+template <size_t N>
+int lookup(const char* const (&names)[N], const char* name) {
+    for (size_t i = 0; name && i < N; ++i) {
+        if (strcmp(names[i], name) == 0) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+WidgetType parseWidget(const char* name) {
+    for (uint8_t w = 1; name && name[0] && w <= static_cast<uint8_t>(WidgetType::FFT); ++w) {
+        if (strcmp(widgetName(static_cast<WidgetType>(w)), name) == 0) return static_cast<WidgetType>(w);
+    }
+    return WidgetType::None;
+}
+
+GroupWidget parseGroupWidget(const char* name) {
+    for (uint8_t w = 1; name && name[0] && w <= static_cast<uint8_t>(GroupWidget::Accelerometer); ++w) {
+        if (strcmp(groupWidgetName(static_cast<GroupWidget>(w)), name) == 0) return static_cast<GroupWidget>(w);
+    }
+    return GroupWidget::None;
+}
+
+Checksum parseChecksum(const char* name) {
+    for (uint8_t c = 1; name && name[0] && c <= static_cast<uint8_t>(Checksum::Crc32); ++c) {
+        if (strcmp(checksumName(static_cast<Checksum>(c)), name) == 0) return static_cast<Checksum>(c);
+    }
+    return Checksum::None;
+}
+
+const char* text(JsonVariantConst v) {
+    return v.is<const char*>() ? v.as<const char*>() : nullptr;
+}
+
+bool flag(JsonVariantConst v, bool fallback) {
+    return v.is<bool>() ? v.as<bool>() : fallback;
+}
+
+/**
+ * Lays the project out into an image.  Runs twice: once with base ==
+ * nullptr to size the string pool, then again to fill a buffer of the
+ * final size.  Pointer fields are written as image offsets.
+ */
+class ImageBuilder {
+public:
+    ImageBuilder(uint8_t* base, size_t pool) : base_(base), pool_(pool) {}
+
+    size_t pool() const { return pool_; }
+
+    /** False once a value was rejected; compile() then fails. */
+    bool ok() const { return ok_; }
+
+    /** Record that @p key held a value the image cannot represent. */
+    void reject(const char* key) {
+#ifdef ARDUINO
+        if (ok_) Serial.printf("[ss] layout: invalid \"%s\"\n", key);
+#else
+        (void)key;
+#endif
+        ok_ = false;
+    }
+
+    /**
+     * Index of @p d[key] in @p names; @p fallback when the key is absent.
+     * A name that is not in the list is rejected rather than defaulted.
+     */
+    template <size_t N>
+    uint8_t name(JsonVariantConst d, const char* key,
+                 const char* const (&names)[N], uint8_t fallback) {
+        const JsonVariantConst v = d[key];
+        if (v.isNull()) return fallback;
+        const int i = lookup(names, text(v));
+        if (i < 0) {
+            reject(key);
+            return fallback;
+        }
+        return static_cast<uint8_t>(i);
+    }
+
+    /**
+     * @p d[key] as a T; @p fallback when it is absent or not a number.  A
+     * number outside T's range is rejected: converting it would be
+     * undefined behaviour, and project files come from users.
+     */
+    template <typename T>
+    T number(JsonVariantConst d, const char* key, T fallback) {
+        const JsonVariantConst v = d[key];
+        if (!v.is<double>()) return fallback;
+        const double x = v.as<double>();
+        // Written so that NaN fails both comparisons.
+        if (!(x >= static_cast<double>(std::numeric_limits<T>::lowest()) &&
+              x <= static_cast<double>(std::numeric_limits<T>::max()))) {
+            reject(key);
+            return fallback;
+        }
+        return static_cast<T>(x);
+    }
+
+    /** Append @p s to the string pool; returns its offset as a pointer. */
+    const char* string(const char* s) {
+        if (!s) return nullptr;
+        const size_t n   = strlen(s) + 1;
+        const size_t off = pool_;
+        if (base_) memcpy(base_ + off, s, n);
+        pool_ += n;
+        return reinterpret_cast<const char*>(off);
+    }
+
+    template <typename T>
+    void put(size_t off, const T& v) {
+        if (base_) memcpy(base_ + off, &v, sizeof(T));
+    }
+
+    template <typename T>
+    static const T* offset(size_t off) {
+        return reinterpret_cast<const T*>(off);
+    }
+
+private:
+    uint8_t* base_;
+    size_t   pool_;
+    bool     ok_ = true;
+};
+
+DatasetCfg parseDataset(JsonVariantConst d, ImageBuilder& b) {
+    DatasetCfg ds{};
+    ds.title           = b.string(text(d[Keys::Title]));
+    ds.units           = b.string(text(d[Keys::Units]) ? text(d[Keys::Units]) : "");
+    ds.telemetryKey    = b.string(text(d["telemetryKey"]));
+    ds.index           = b.number<uint8_t>(d, Keys::Index, 0);
+    ds.widget          = parseWidget(text(d[Keys::Widget]));
+    ds.widgetMin       = b.number<float>(d, Keys::WgtMin, 0.0f);
+    ds.widgetMax       = b.number<float>(d, Keys::WgtMax, 0.0f);
+    ds.plotMin         = b.number<float>(d, Keys::PltMin, 0.0f);
+    ds.plotMax         = b.number<float>(d, Keys::PltMax, 0.0f);
+    ds.alarmLow        = b.number<float>(d, Keys::AlarmLow, 0.0f);
+    ds.alarmHigh       = b.number<float>(d, Keys::AlarmHigh, 0.0f);
+    ds.alarmEnabled    = flag(d[Keys::AlarmEnabled], false);
+    ds.graph           = flag(d[Keys::Graph], false);
+    ds.log             = flag(d[Keys::Log], false);
+    ds.led             = flag(d[Keys::LED], false);
+    ds.ledHigh         = b.number<uint8_t>(d, Keys::LedHigh, 0);
+    ds.overviewDisplay = flag(d[Keys::Overview], false);
+    ds.fft             = flag(d[Keys::FFT], false);
+    ds.fftSamples      = b.number<uint16_t>(d, Keys::FFTSamples, Defaults::FFTSamples);
+    ds.fftSamplingRate = b.number<uint16_t>(d, Keys::FFTSamplingRate, Defaults::FFTSamplingRate);
+    ds.xAxis           = b.number<int8_t>(d, Keys::XAxis, Defaults::XAxis);
+    ds.aggregate       = static_cast<Aggregate>(b.name(d, "aggregate", kAggregateNames, 0));
+    ds.alarmHysteresis = b.number<float>(d, "alarmHysteresis", 0.0f);
+    ds.alarmImmediate  = flag(d["alarmImmediate"], false);
+    ds.priority        = static_cast<Priority>(b.name(d, "priority", kPriorityNames, 1));
+    ds.updateEvery     = b.number<uint8_t>(d, "updateEvery", 1);
+    ds.maxRateHz       = b.number<uint16_t>(d, "maxRateHz", 0);
+    ds.valueWidth      = b.number<uint8_t>(d, "valueWidth", 0);
+    ds.kind            = static_cast<ValueKind>(b.name(d, "kind", kKindNames, 0));
+    return ds;
+}
+
+/** Fill every section at @p at; strings go to the builder's pool. */
+void buildImage(JsonVariantConst root, const Sections& at, ImageBuilder& b) {
+    const JsonArrayConst groups  = root[Keys::Groups].as<JsonArrayConst>();
+    const JsonArrayConst actions = root[Keys::Actions].as<JsonArrayConst>();
+
+    DashboardCfg cfg{};
+    cfg.title        = b.string(text(root[Keys::Title]));
+    cfg.groupCount   = static_cast<uint8_t>(groups.size());
+    cfg.groups       = cfg.groupCount ? ImageBuilder::offset<GroupCfg>(at.groups) : nullptr;
+    cfg.actionCount  = static_cast<uint8_t>(actions.size());
+    cfg.actions      = cfg.actionCount ? ImageBuilder::offset<ActionCfg>(at.actions) : nullptr;
+    cfg.checksum     = parseChecksum(text(root["checksum"]));
+    cfg.decoder      = static_cast<Decoder>(b.number<uint8_t>(root, "decoder", 0));
+    cfg.omitDefaults = flag(root["omitDefaults"], false);
+    if (cfg.decoder > Decoder::Base64) cfg.decoder = Decoder::PlainText;
+    b.put(at.root, cfg);
+
+    size_t g = at.groups;
+    size_t d = at.datasets;
+    for (JsonVariantConst grp : groups) {
+        const JsonArrayConst datasets = grp[Keys::Datasets].as<JsonArrayConst>();
+
+        GroupCfg gc{};
+        gc.title        = b.string(text(grp[Keys::Title]));
+        gc.widget       = parseGroupWidget(text(grp[Keys::Widget]));
+        gc.datasetCount = static_cast<uint8_t>(datasets.size());
+        gc.datasets     = gc.datasetCount ? ImageBuilder::offset<DatasetCfg>(d) : nullptr;
+        b.put(g, gc);
+        g += sizeof(GroupCfg);
+
+        for (JsonVariantConst ds : datasets) {
+            b.put(d, parseDataset(ds, b));
+            d += sizeof(DatasetCfg);
+        }
+    }
+
+    size_t a = at.actions;
+    for (JsonVariantConst act : actions) {
+        ActionCfg ac{};
+        ac.title  = b.string(text(act[Keys::Title]));
+        ac.txData = b.string(text(act[Keys::TxData]));
+        ac.icon   = b.string(text(act[Keys::Icon]));
+        ac.eol    = b.string(text(act[Keys::EOL]) ? text(act[Keys::EOL]) : "\n");
+        b.put(a, ac);
+        a += sizeof(ActionCfg);
+    }
+}
+
+#endif // SS_DASHBOARD_ARDUINOJSON
+
+} // namespace
+
+// ─── Accessors ──────────────────────────────────────────────────────────────
+
+uint32_t LayoutImage::sourceCrc() const {
+    return image_ ? reinterpret_cast<const Header*>(image_.get())->sourceCrc : 0;
+}
+
+uint32_t LayoutImage::sourceSize() const {
+    return image_ ? reinterpret_cast<const Header*>(image_.get())->sourceSize : 0;
+}
+
+// ─── compile() ───────────────────────────────────────────────────────────────
+
+#if SS_DASHBOARD_ARDUINOJSON
+
+bool LayoutImage::compile(const char* json, size_t len) {
+    JsonDocument doc;
+    const DeserializationError err = deserializeJson(doc, json, len);
+    if (err) {
+#ifdef ARDUINO
+        Serial.printf("[ss] layout: project JSON: %s\n", err.c_str());
+#endif
+        return false;
+    }
+
+    const JsonVariantConst root    = doc.as<JsonVariantConst>();
+    const JsonArrayConst   groups  = root[Keys::Groups].as<JsonArrayConst>();
+    const size_t           actions = root[Keys::Actions].size();
+    size_t datasets = 0;
+    bool   fits     = groups.size() <= 0xFF && actions <= 0xFF;
+    for (JsonVariantConst grp : groups) {
+        const size_t n = grp[Keys::Datasets].size();
+        fits      = fits && n <= 0xFF;
+        datasets += n;
+    }
+    if (!fits) {
+#ifdef ARDUINO
+        Serial.printf("[ss] layout: more than 255 groups, datasets per group or actions\n");
+#endif
+        return false;
+    }
+
+    // Pass 1 sizes the string pool; pass 2 fills the image.  The pool
+    // always ends with a NUL so adopt() can bound every string.
+    const Sections at = sections(groups.size(), datasets, actions);
+    ImageBuilder sizing(nullptr, 0);
+    buildImage(root, at, sizing);
+    if (!sizing.ok()) return false;
+    const size_t size = at.pool + sizing.pool() + 1;
+
+    std::unique_ptr<uint8_t[]> image(new (std::nothrow) uint8_t[size]());
+    if (!image) return false;
+
+    ImageBuilder fill(image.get(), at.pool);
+    buildImage(root, at, fill);
+
+    Header h{};
+    h.magic         = kMagic;
+    h.version       = kVersion;
+    h.structSize[0] = sizeof(DashboardCfg);
+    h.structSize[1] = sizeof(GroupCfg);
+    h.structSize[2] = sizeof(DatasetCfg);
+    h.structSize[3] = sizeof(ActionCfg);
+    h.size          = static_cast<uint32_t>(size);
+    h.sourceSize    = static_cast<uint32_t>(len);
+    h.sourceCrc     = crc32(reinterpret_cast<const uint8_t*>(json), len);
+    h.datasetCount  = static_cast<uint16_t>(datasets);
+    h.groupCount    = static_cast<uint8_t>(groups.size());
+    h.actionCount   = static_cast<uint8_t>(actions);
+    h.crc           = crc32(image.get() + sizeof(Header), size - sizeof(Header));
+    memcpy(image.get(), &h, sizeof(Header));
+
+    return adopt(std::move(image), size);
+}
+
+#endif // SS_DASHBOARD_ARDUINOJSON
+
+// ─── load() / adopt() ────────────────────────────────────────────────────────
+
+bool LayoutImage::load(const uint8_t* data, size_t len) {
+    if (!data || len < sizeof(Header)) return false;
+    std::unique_ptr<uint8_t[]> image(new (std::nothrow) uint8_t[len]);
+    if (!image) return false;
+    memcpy(image.get(), data, len);
+    return adopt(std::move(image), len);
+}
+
+bool LayoutImage::adopt(std::unique_ptr<uint8_t[]> image, size_t len) {
+    uint8_t* const base = image.get();
+    if (len < sizeof(Header)) return false;
+
+    Header h;
+    memcpy(&h, base, sizeof(Header));
+    const bool valid = h.magic == kMagic && h.version == kVersion &&
+                       h.structSize[0] == sizeof(DashboardCfg) &&
+                       h.structSize[1] == sizeof(GroupCfg) &&
+                       h.structSize[2] == sizeof(DatasetCfg) &&
+                       h.structSize[3] == sizeof(ActionCfg) &&
+                       h.size == len &&
+                       h.crc == crc32(base + sizeof(Header), len - sizeof(Header));
+    const Sections at = sections(h.groupCount, h.datasetCount, h.actionCount);
+    if (!valid || at.pool >= len || base[len - 1] != '\0') {
+#ifdef ARDUINO
+        Serial.printf("[ss] layout: image rejected (corrupt or from another build)\n");
+#endif
+        return false;
+    }
+
+    // Relocate in place.  Strings must lie in the pool, which ends in a NUL,
+    // so every string is terminated inside the image.
+    const size_t pool = at.pool;
+    bool ok = true;
+
+    auto* cfg = reinterpret_cast<DashboardCfg*>(base + at.root);
+    ok = ok && toPointer(cfg->title, base, pool, len);
+    cfg->groups      = h.groupCount  ? reinterpret_cast<const GroupCfg*>(base + at.groups)   : nullptr;
+    cfg->groupCount  = h.groupCount;
+    cfg->actions     = h.actionCount ? reinterpret_cast<const ActionCfg*>(base + at.actions) : nullptr;
+    cfg->actionCount = h.actionCount;
+
+    const size_t datasetsEnd = at.datasets + h.datasetCount * sizeof(DatasetCfg);
+    auto* groups = reinterpret_cast<GroupCfg*>(base + at.groups);
+    for (uint8_t i = 0; ok && i < h.groupCount; ++i) {
+        GroupCfg& g = groups[i];
+        const auto off = reinterpret_cast<uintptr_t>(g.datasets);
+        ok = toPointer(g.title, base, pool, len) &&
+             (g.datasetCount == 0 ||
+              (off >= at.datasets && (off - at.datasets) % sizeof(DatasetCfg) == 0 &&
+               off + g.datasetCount * sizeof(DatasetCfg) <= datasetsEnd)) &&
+             toPointer(g.datasets, base, at.datasets, datasetsEnd);
+    }
+
+    auto* datasets = reinterpret_cast<DatasetCfg*>(base + at.datasets);
+    for (uint16_t i = 0; ok && i < h.datasetCount; ++i) {
+        DatasetCfg& d = datasets[i];
+        ok = toPointer(d.title, base, pool, len) &&
+             toPointer(d.units, base, pool, len) &&
+             toPointer(d.telemetryKey, base, pool, len);
+        d.labels     = nullptr;   // label tables live in firmware, not in images
+        d.labelCount = 0;
+    }
+
+    auto* actions = reinterpret_cast<ActionCfg*>(base + at.actions);
+    for (uint8_t i = 0; ok && i < h.actionCount; ++i) {
+        ActionCfg& a = actions[i];
+        ok = toPointer(a.title, base, pool, len) &&
+             toPointer(a.txData, base, pool, len) &&
+             toPointer(a.icon, base, pool, len) &&
+             toPointer(a.eol, base, pool, len);
+    }
+
+    if (!ok) {
+#ifdef ARDUINO
+        Serial.printf("[ss] layout: image has out-of-range references\n");
+#endif
+        return false;
+    }
+
+    image_ = std::move(image);
+    size_  = len;
+    cfg_   = *cfg;
+    return true;
+}
+
+// ─── save() ──────────────────────────────────────────────────────────────────
+
+bool LayoutImage::save(SinkFn sink, void* ctx) const {
+    if (!image_ || !sink) return false;
+
+    const uint8_t* base = image_.get();
+    const auto*    h    = reinterpret_cast<const Header*>(base);
+    const Sections at   = sections(h->groupCount, h->datasetCount, h->actionCount);
+    ImageWriter    out(sink, ctx, base);
+
+    out.upTo(at.root);
+    out.object<DashboardCfg>([base](DashboardCfg& c) {
+        toOffset(c.title, base);
+        toOffset(c.groups, base);
+        toOffset(c.actions, base);
+    });
+    out.upTo(at.groups);
+    for (uint8_t i = 0; i < h->groupCount; ++i) {
+        out.object<GroupCfg>([base](GroupCfg& g) {
+            toOffset(g.title, base);
+            toOffset(g.datasets, base);
+        });
+    }
+    out.upTo(at.datasets);
+    for (uint16_t i = 0; i < h->datasetCount; ++i) {
+        out.object<DatasetCfg>([base](DatasetCfg& d) {
+            toOffset(d.title, base);
+            toOffset(d.units, base);
+            toOffset(d.telemetryKey, base);
+            d.labels     = nullptr;
+            d.labelCount = 0;
+        });
+    }
+    out.upTo(at.actions);
+    for (uint8_t i = 0; i < h->actionCount; ++i) {
+        out.object<ActionCfg>([base](ActionCfg& a) {
+            toOffset(a.title, base);
+            toOffset(a.txData, base);
+            toOffset(a.icon, base);
+            toOffset(a.eol, base);
+        });
+    }
+    out.upTo(size_);
+    return out.ok();
+}
+
+// ─── begin() — filesystem front end ─────────────────────────────────────────
+
+#ifdef ARDUINO
+
+bool LayoutImage::begin(fs::FS& fs, const char* jsonPath, const char* imagePath) {
+    // Stamp the project file without parsing it.
+    File src = fs.open(jsonPath, "r");
+    const bool haveSource = src && !src.isDirectory();
+    uint32_t   srcSize    = 0;
+    uint32_t   srcCrc     = 0;
+    if (haveSource) {
+        FrameCrc crc(Checksum::Crc32);
+        uint8_t  chunk[128];
+        size_t   n;
+        while ((n = src.read(chunk, sizeof(chunk))) > 0) {
+            crc.update(chunk, n);
+            srcSize += n;
+        }
+        srcCrc = crc.value();
+    }
+
+    // Warm path: the image is current, read it straight into place.
+    File img = fs.open(imagePath, "r");
+    if (img && !img.isDirectory() && img.size() >= sizeof(Header)) {
+        Header h;
+        const size_t len = img.size();
+        if (img.read(reinterpret_cast<uint8_t*>(&h), sizeof(Header)) == sizeof(Header) &&
+            (!haveSource || (h.sourceSize == srcSize && h.sourceCrc == srcCrc))) {
+            std::unique_ptr<uint8_t[]> image(new (std::nothrow) uint8_t[len]);
+            if (image) {
+                memcpy(image.get(), &h, sizeof(Header));
+                const size_t rest = len - sizeof(Header);
+                if (img.read(image.get() + sizeof(Header), rest) == rest &&
+                    adopt(std::move(image), len)) {
+                    return true;
+                }
+            }
+        }
+    }
+    img.close();
+
+    if (!haveSource) {
+        Serial.printf("[ss] layout: no usable %s and no %s\n", imagePath, jsonPath);
+        return false;
+    }
+
+#if SS_DASHBOARD_ARDUINOJSON
+    // Cold path: compile the project file and cache the image.
+    std::unique_ptr<char[]> json(new (std::nothrow) char[srcSize]);
+    if (!json || !src.seek(0) || src.read(reinterpret_cast<uint8_t*>(json.get()), srcSize) != srcSize ||
+        !compile(json.get(), srcSize)) {
+        Serial.printf("[ss] layout: cannot compile %s\n", jsonPath);
+        return false;
+    }
+    json.reset();
+    src.close();
+
+    File out = fs.open(imagePath, "w");
+    const bool saved = out && save([](void* ctx, const uint8_t* data, size_t len) -> size_t {
+        return static_cast<File*>(ctx)->write(data, len);
+    }, &out);
+    if (!saved) Serial.printf("[ss] layout: cannot write %s\n", imagePath);
+    return true;
+#else
+    Serial.printf("[ss] layout: %s is stale; minimal build cannot compile %s\n",
+                  imagePath, jsonPath);
+    return false;
+#endif
+}
+
+#endif // ARDUINO
+
+} // namespace ss
@@ -0,0 +1,125 @@
+/**
+ * @file ss_layout_image.h
+ * @brief Dashboard layouts loaded from files instead of compiled in.
+ *
+ * A LayoutImage holds a complete DashboardCfg — groups, datasets, actions
+ * and every string they point to — in one relocatable block of memory.
+ * compile() builds the image from a Serial Studio project JSON file (full
+ * build profile only); save() writes it out and load() reads it back with
+ * nothing more than a CRC check and a pointer fix-up per field, so a warm
+ * boot never parses JSON.
+ *
+ * On ESP32, begin(fs, jsonPath, imagePath) does the whole dance against
+ * LittleFS or SPIFFS: it uses the image while it still matches the JSON
+ * file, and recompiles (and rewrites the image) when the JSON has changed.
+ * Uploading a new project file is then enough to change the layout of a
+ * unit in the field — no reflash.
+ *
+ * The project file uses Serial Studio's own keys.  Device-side settings that
+ * Serial Studio does not know about use the DatasetCfg / DashboardCfg field
+ * names as extra keys:
+ *
+ * @code
+ *   { "title": "Greenhouse", "checksum": "CRC-16-CCITT", "omitDefaults": true,
+ *     "groups": [ { "title": "Air", "widget": "datagrid", "datasets": [
+ *       { "title": "Temperature", "units": "°C", "widget": "gauge",
+ *         "widgetMin": -10, "widgetMax": 50, "graph": true,
+ *         "telemetryKey": "air.t", "aggregate": "mean" } ] } ] }
+ * @endcode
+ *
+ * The Dashboard borrows config() like any other DashboardCfg, so the
+ * LayoutImage must outlive it, and reloading an image must be followed by
+ * Dashboard::begin().
+ */
+
+#pragma once
+
+#include "ss_profile.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "ss_dashboard_config.h"
+
+#ifdef ARDUINO
+#include <FS.h>
+#endif
+
+namespace ss {
+
+class LayoutImage {
+public:
+    /// "SSLI", little-endian.
+    static constexpr uint32_t kMagic   = 0x494C5353u;
+    static constexpr uint16_t kVersion = 1;
+
+    /**
+     * Image sink for save().  Same contract as FrameCoalescer::SinkFn.
+     *
+     * @return Bytes accepted; anything short of @p len fails the save.
+     */
+    using SinkFn = size_t (*)(void* ctx, const uint8_t* data, size_t len);
+
+    LayoutImage() = default;
+    LayoutImage(const LayoutImage&)            = delete;
+    LayoutImage& operator=(const LayoutImage&) = delete;
+
+#if SS_DASHBOARD_ARDUINOJSON
+    /**
+     * Build the image from a project JSON document.
+     *
+     * @return false if the JSON does not parse, the project has more than
+     *         255 groups / datasets per group / actions, or the image
+     *         cannot be allocated.  The previous image is kept on failure.
+     */
+    bool compile(const char* json, size_t len);
+#endif
+
+    /**
+     * Copy an image produced by save() and relocate it.
+     *
+     * @return false if the image is truncated or corrupt, or was written by
+     *         a build with a different image version or struct layout.  The
+     *         previous image is kept on failure.
+     */
+    bool load(const uint8_t* data, size_t len);
+
+    /** Write the image in the form load() accepts. */
+    bool save(SinkFn sink, void* ctx) const;
+
+#ifdef ARDUINO
+    /**
+     * Load the layout from a filesystem (LittleFS, SPIFFS, SD…).
+     *
+     * Uses @p imagePath when it was compiled from the current contents of
+     * @p jsonPath (or when @p jsonPath does not exist); otherwise compiles
+     * @p jsonPath and rewrites @p imagePath.  Checking the JSON costs one
+     * streamed read and a CRC, not a parse.  In the minimal build profile a
+     * missing or stale image fails.
+     */
+    bool begin(fs::FS& fs, const char* jsonPath, const char* imagePath);
+#endif
+
+    /** True once an image is loaded. */
+    bool loaded() const { return image_ != nullptr; }
+
+    /** The loaded layout; empty until compile() / load() succeed. */
+    const DashboardCfg& config() const { return cfg_; }
+
+    /** Image size in bytes, as written by save(). */
+    size_t size() const { return size_; }
+
+    /** CRC-32 and length of the JSON the image was compiled from. */
+    uint32_t sourceCrc() const;
+    uint32_t sourceSize() const;
+
+private:
+    /** Take ownership of an image still in offset form and relocate it. */
+    bool adopt(std::unique_ptr<uint8_t[]> image, size_t len);
+
+    std::unique_ptr<uint8_t[]> image_;
+    size_t                     size_ = 0;
+    DashboardCfg               cfg_;
+};
+
+} // namespace ss
@@ -0,0 +1,60 @@
+/**
+ * @file ss_profile.h
+ * @brief Build-profile switches for the dashboard library.
+ *
+ * SS_DASHBOARD_ARDUINOJSON (default 1)
+ *   1  Full profile.  Dashboard::update(const JsonDocument&) is available
+ *      (ss_dashboard_json.cpp) and the DashboardIconMap / ActionIconMap
+ *      lookup tables are defined.
+ *   0  Minimal profile.  Nothing in the library includes ArduinoJson or
+ *      builds a std::map; values arrive through the typed setters
+ *      (setValue() / setText()) only.  Intended for small parts such as the
+ *      ESP32-C3 where telemetry should be a small add-on to the image.
+ *
+ * Output is identical in both profiles: the project frame always comes from
+ * the cached template built by begin().
+ *
+ * Table sizes (Dashboard::kMaxGroups / kMaxDatasets / kMaxSlots /
+ * kMaxFftSlots) are fixed arrays inside the Dashboard object, so they set
+ * sizeof(Dashboard).  The minimal profile defaults to a small layout;
+ * override any of them with -D to fit the config:
+ *
+ *   SS_MAX_GROUPS     Groups, config plus runtime additions   (16 / 4)
+ *   SS_MAX_DATASETS   Datasets, config plus runtime additions (64 / 16)
+ *   SS_MAX_SLOTS      Datasets with a value slot, at most 64  (48 / 16)
+ *   SS_MAX_FFT_SLOTS  FFT datasets with a sample ring         (8 / 2)
+ */
+
+#pragma once
+
+#ifndef SS_DASHBOARD_ARDUINOJSON
+#define SS_DASHBOARD_ARDUINOJSON 1
+#endif
+
+#if SS_DASHBOARD_ARDUINOJSON
+#  ifndef SS_MAX_GROUPS
+#  define SS_MAX_GROUPS 16
+#  endif
+#  ifndef SS_MAX_DATASETS
+#  define SS_MAX_DATASETS 64
+#  endif
+#  ifndef SS_MAX_SLOTS
+#  define SS_MAX_SLOTS 48
+#  endif
+#  ifndef SS_MAX_FFT_SLOTS
+#  define SS_MAX_FFT_SLOTS 8
+#  endif
+#else
+#  ifndef SS_MAX_GROUPS
+#  define SS_MAX_GROUPS 4
+#  endif
+#  ifndef SS_MAX_DATASETS
+#  define SS_MAX_DATASETS 16
+#  endif
+#  ifndef SS_MAX_SLOTS
+#  define SS_MAX_SLOTS 16
+#  endif
+#  ifndef SS_MAX_FFT_SLOTS
+#  define SS_MAX_FFT_SLOTS 2
+#  endif
+#endif
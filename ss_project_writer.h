@@ -0,0 +1,689 @@
+/**
+ * @file ss_project_writer.h
+ * @brief Compile-time (constexpr) Serial Studio project JSON writer.
+ *
+ * ProjectWriter renders a DashboardCfg into the same compact project JSON
+ * that Dashboard::begin() + serialize() produce at boot, using only constexpr
+ * operations, so the whole project frame can be baked into flash:
+ *
+ * @code
+ *   static constexpr ss::DashboardCfg kCfg = { ... };   // constexpr, not const
+ *
+ *   using Project = ss::StaticProject<kCfg>;
+ *   char txBuf[Project::kFrameSize];                     // exact size
+ *   Serial.write(Project::frame(), Project::kFrameSize);
+ * @endcode
+ *
+ * Every GroupCfg / DatasetCfg / ActionCfg array reachable from the config
+ * must be constexpr as well.  Numbers are written like printf("%.6g").
+ *
+ * The writer is templated on its sink: CountingSink sizes the output in a
+ * first pass and FixedString<N> stores it in a second, so the storage is
+ * exactly as large as the JSON.  A sink provides put(char) for static text
+ * and hole(ordinal) for each dataset's value; the Dashboard's own sinks use
+ * hole() to build its value-patched templates from the very same writer, so
+ * the compile-time and runtime frames are identical.
+ *
+ * With DashboardCfg::omitDefaults set, fields whose value equals the default
+ * Serial Studio assumes for a missing key are left out.  projectFieldCosts()
+ * reports what each key costs, and how much of that omission would save.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include "ss_dashboard_config.h"
+#include "ss_keys.h"
+
+namespace ss {
+
+// ─── Enum → JSON names ───────────────────────────────────────────────────────
+
+constexpr const char* widgetName(WidgetType w) {
+    switch (w) {
+        case WidgetType::Gauge: return "gauge";
+        case WidgetType::Bar:   return "bar";
+        case WidgetType::Led:   return "led";
+        default:                return "";
+    }
+}
+
+constexpr const char* groupWidgetName(GroupWidget w) {
+    switch (w) {
+        case GroupWidget::Multiplot:     return "multiplot";
+        case GroupWidget::Datagrid:      return "datagrid";
+        case GroupWidget::Accelerometer: return "accelerometer";
+        default:                         return "";
+    }
+}
+
+/**
+ * Frame parser installed in the project for the binary decoders: unpacks
+ * the decoded payload into one little-endian float32 per dataset.
+ */
+inline constexpr char kFloat32Parser[] =
+    "function parse(frame) {\n"
+    "    var n = frame.length;\n"
+    "    var bytes = new Uint8Array(n);\n"
+    "    for (var i = 0; i < n; ++i)\n"
+    "        bytes[i] = typeof frame === 'string' ? frame.charCodeAt(i) & 0xFF : frame[i];\n"
+    "    var view = new DataView(bytes.buffer);\n"
+    "    var out = [];\n"
+    "    for (var o = 0; o + 4 <= n; o += 4) out.push(view.getFloat32(o, true));\n"
+    "    return out;\n"
+    "}";
+
+// ─── Serial Studio defaults ──────────────────────────────────────────────────
+//
+// Values Serial Studio assumes when a key is missing from the project file.
+// Only these fields are dropped by DashboardCfg::omitDefaults; title, index,
+// value, eol, txData and every other field are always written.
+
+namespace Defaults {
+inline constexpr int      XAxis           = -1;
+inline constexpr uint16_t FFTSamples      = 256;
+inline constexpr uint16_t FFTSamplingRate = 100;
+inline constexpr int      TimerInterval   = 100;
+inline constexpr int      TimerMode       = 0;
+} // namespace Defaults
+
+// ─── Sinks ───────────────────────────────────────────────────────────────────
+
+/** Sink that only counts bytes. */
+struct CountingSink {
+    size_t size = 0;
+    constexpr void put(char) { ++size; }
+    constexpr void hole(uint8_t) { ++size; }   // "0" placeholder
+};
+
+/** Fixed-capacity, NUL-terminated character array sink. */
+template <size_t N>
+struct FixedString {
+    char   data[N + 1] = {};
+    size_t size        = 0;
+
+    constexpr void put(char c) {
+        if (size < N) data[size++] = c;
+    }
+
+    constexpr void hole(uint8_t) { put('0'); }
+};
+
+/**
+ * Optional sink hook: a sink with field(const char* key, bool isDefault) is
+ * told which key the following bytes belong to (nullptr for braces,
+ * brackets and the commas between array elements).
+ */
+template <typename S, typename = void>
+struct HasFieldHook : std::false_type {};
+
+template <typename S>
+struct HasFieldHook<S, std::void_t<decltype(std::declval<S&>().field("", false))>>
+    : std::true_type {};
+
+// ─── Number formatting ───────────────────────────────────────────────────────
+
+/**
+ * Write @p v to @p out like printf("%.6g") — six significant digits,
+ * trailing zeros trimmed, exponent form outside [1e-4, 1e6).  Non-finite
+ * values are written as "nan" / "inf" / "-inf".
+ */
+template <typename Sink>
+constexpr void formatNumber(Sink& out, double v) {
+    auto digitsOf = [&out](unsigned long long u) {
+        char   tmp[20] = {};
+        size_t n       = 0;
+        do { tmp[n++] = static_cast<char>('0' + u % 10); u /= 10; } while (u);
+        while (n) out.put(tmp[--n]);
+    };
+
+    if (v != v) { out.put('n'); out.put('a'); out.put('n'); return; }
+    if (v < 0) { out.put('-'); v = -v; }
+    if (v > 1.7976931348623157e308) { out.put('i'); out.put('n'); out.put('f'); return; }
+    if (v == 0) { out.put('0'); return; }
+
+    // Six significant digits: scale into [1e5, 1e6) and round.
+    int exp10 = 0;
+    while (v >= 1e6) { v /= 10; ++exp10; }
+    while (v < 1e5)  { v *= 10; --exp10; }
+    auto digits = static_cast<unsigned long>(v + 0.5);
+    if (digits >= 1000000ul) { digits /= 10; ++exp10; }
+    const int e = exp10 + 5;   // decimal exponent of the leading digit
+
+    char d[6] = {};
+    for (int i = 5; i >= 0; --i) { d[i] = static_cast<char>('0' + digits % 10); digits /= 10; }
+    int last = 5;
+    while (last > 0 && d[last] == '0') --last;
+
+    if (e < -4 || e >= 6) {
+        out.put(d[0]);
+        if (last > 0) { out.put('.'); for (int i = 1; i <= last; ++i) out.put(d[i]); }
+        out.put('e');
+        out.put(e < 0 ? '-' : '+');
+        const int ae = e < 0 ? -e : e;
+        if (ae < 10) out.put('0');
+        digitsOf(static_cast<unsigned long long>(ae));
+    } else if (e < 0) {
+        out.put('0'); out.put('.');
+        for (int i = -1; i > e; --i) out.put('0');
+        for (int i = 0; i <= last; ++i) out.put(d[i]);
+    } else {
+        for (int i = 0; i <= e; ++i) out.put(d[i]);
+        if (last > e) { out.put('.'); for (int i = e + 1; i <= last; ++i) out.put(d[i]); }
+    }
+}
+
+// ─── ProjectWriter ───────────────────────────────────────────────────────────
+
+template <typename Sink>
+class ProjectWriter {
+public:
+    /**
+     * @param sink    Output sink.
+     * @param indent  Spaces per nesting level; 0 writes compact JSON.  Pretty
+     *                output uses CRLF line breaks, like serializeJsonPretty().
+     */
+    constexpr explicit ProjectWriter(Sink& sink, uint8_t indent = 0)
+        : out_(sink), indent_(indent) {}
+
+    /** Write the project JSON for @p cfg, with every value at its "0" placeholder. */
+    constexpr void project(const DashboardCfg& cfg) {
+        header(cfg);
+        uint8_t autoIndex = 1;
+        for (uint8_t gi = 0; gi < cfg.groupCount; ++gi) {
+            const GroupCfg& g = cfg.groups[gi];
+            groupOpen(g);
+            for (uint8_t di = 0; di < g.datasetCount; ++di) dataset(g.datasets[di], autoIndex++);
+            groupClose();
+        }
+        footer();
+    }
+
+    // ── Project pieces ───────────────────────────────────────────────────────
+    //
+    // project() is header(), one groupOpen() / dataset()… / groupClose() per
+    // group, then footer().  The pieces can also be written separately — the
+    // Dashboard keeps one segment per group so a layout change re-renders
+    // only that group.  enterGroups() puts a fresh writer where header()
+    // leaves off: inside the "groups" array, before the first element when
+    // @p afterElement is false (a group segment) or after one when true (the
+    // footer).  Consecutive group segments are then joined with a ','.
+
+    /** Everything up to and including the "groups" array's '['. */
+    constexpr void header(const DashboardCfg& cfg) {
+        omit_ = cfg.omitDefaults;
+
+        open('{');
+        key(Keys::Title); str(cfg.title ? cfg.title : "Dashboard");
+
+        if (want(Keys::Actions, cfg.actionCount == 0)) {
+            open('[');
+            for (uint8_t i = 0; i < cfg.actionCount; ++i) action(cfg.actions[i]);
+            close(']');
+        }
+
+        if (want("checksum", cfg.checksum == Checksum::None)) str(checksumName(cfg.checksum));
+        if (want("decoder", cfg.decoder == Decoder::PlainText)) {
+            integer(static_cast<uint8_t>(cfg.decoder));
+        }
+        if (cfg.decoder != Decoder::PlainText) {
+            key("frameParser"); str(kFloat32Parser);
+        }
+        if (want("hexadecimalDelimiters", true)) boolean(false);
+
+        key(Keys::DashboardLayout); open('{');
+        key("autoLayout");  boolean(true);
+        key("windowOrder"); open('['); close(']');
+        close('}');
+
+        key(Keys::Groups); open('[');
+    }
+
+    constexpr void enterGroups(const DashboardCfg& cfg, bool afterElement) {
+        omit_     = cfg.omitDefaults;
+        depth_    = 2;
+        comma_    = afterElement;
+        empty_    = !afterElement;
+        afterKey_ = false;
+    }
+
+    /** A group object up to and including its "datasets" array's '['. */
+    constexpr void groupOpen(const GroupCfg& g) {
+        open('{');
+        key(Keys::Title);  str(g.title ? g.title : "");
+        if (want(Keys::Widget, g.widget == GroupWidget::None)) str(groupWidgetName(g.widget));
+        key(Keys::Datasets); open('[');
+    }
+
+    constexpr void groupClose() {
+        close(']');
+        close('}');
+    }
+
+    /** One dataset object; @p index is its 1-based Serial Studio index. */
+    constexpr void dataset(const DatasetCfg& ds, uint8_t index) {
+        open('{');
+        if (want(Keys::AlarmEnabled,    !ds.alarmEnabled))           boolean(ds.alarmEnabled);
+        if (want(Keys::AlarmHigh,       ds.alarmHigh == 0))          number(ds.alarmHigh);
+        if (want(Keys::AlarmLow,        ds.alarmLow == 0))           number(ds.alarmLow);
+        if (want(Keys::FFT,             !ds.fft))                    boolean(ds.fft);
+        if (want(Keys::FFTMax,          true))                       integer(0);
+        if (want(Keys::FFTMin,          true))                       integer(0);
+        if (want(Keys::FFTSamples,      ds.fftSamples == Defaults::FFTSamples)) {
+            integer(ds.fftSamples);
+        }
+        if (want(Keys::FFTSamplingRate, ds.fftSamplingRate == Defaults::FFTSamplingRate)) {
+            integer(ds.fftSamplingRate);
+        }
+        if (want(Keys::Graph,           !ds.graph))                  boolean(ds.graph);
+        key(Keys::Index);           integer(index);
+        if (want(Keys::LED,             !ds.led))                    boolean(ds.led);
+        if (want(Keys::LedHigh,         ds.ledHigh == 0))            integer(ds.ledHigh);
+        if (want(Keys::Log,             !ds.log))                    boolean(ds.log);
+        if (want(Keys::Overview,        !ds.overviewDisplay))        boolean(ds.overviewDisplay);
+        if (want(Keys::PltMax,          ds.plotMax == 0))            number(ds.plotMax);
+        if (want(Keys::PltMin,          ds.plotMin == 0))            number(ds.plotMin);
+        key(Keys::Title);           str(ds.title ? ds.title : "");
+        if (want(Keys::Units,           !ds.units || !ds.units[0]))  str(ds.units ? ds.units : "");
+        key(Keys::Value);           valueHole(static_cast<uint8_t>(index - 1));
+        if (want(Keys::Widget,          ds.widget == WidgetType::None)) str(widgetName(ds.widget));
+        if (want(Keys::WgtMax,          ds.widgetMax == 0))          number(ds.widgetMax);
+        if (want(Keys::WgtMin,          ds.widgetMin == 0))          number(ds.widgetMin);
+        if (want(Keys::XAxis,           ds.xAxis == Defaults::XAxis)) integer(ds.xAxis);
+        close('}');
+    }
+
+    /** Closes the "groups" array and the project object. */
+    constexpr void footer() {
+        close(']');
+        close('}');
+    }
+
+    // ── JSON primitives ──────────────────────────────────────────────────────
+
+    constexpr void open(char c) {
+        hook(nullptr, false);
+        sep();
+        out_.put(c);
+        ++depth_;
+        comma_ = false;
+        empty_ = true;
+    }
+
+    constexpr void close(char c) {
+        hook(nullptr, false);
+        --depth_;
+        if (indent_ && !empty_) newline();
+        out_.put(c);
+        comma_ = true;
+        empty_ = false;
+    }
+
+    constexpr void key(const char* k, bool isDefault = false) {
+        hook(k, isDefault);
+        sep();
+        quoted(k);
+        out_.put(':');
+        if (indent_) out_.put(' ');
+        afterKey_ = true;
+    }
+
+    constexpr void str(const char* s) { sep(); quoted(s); comma_ = true; }
+
+    constexpr void boolean(bool b) { sep(); raw(b ? "true" : "false"); comma_ = true; }
+
+    constexpr void integer(long long v) {
+        sep();
+        if (v < 0) out_.put('-');
+        unsignedDigits(v < 0 ? 0ull - static_cast<unsigned long long>(v)
+                             : static_cast<unsigned long long>(v));
+        comma_ = true;
+    }
+
+    /** printf("%.6g")-style number; NaN / infinity become null, as in ArduinoJson. */
+    constexpr void number(double v) {
+        sep();
+        comma_ = true;
+        if (v != v || v > 1.7976931348623157e308 || v < -1.7976931348623157e308) {
+            raw("null");
+            return;
+        }
+        formatNumber(out_, v);
+    }
+
+    /** A dataset's value string, filled in by the sink's hole(). */
+    constexpr void valueHole(uint8_t ordinal) {
+        sep();
+        out_.put('"');
+        out_.hole(ordinal);
+        out_.put('"');
+        comma_ = true;
+    }
+
+    constexpr void raw(const char* s) { while (*s) out_.put(*s++); }
+
+private:
+    // Write key @p k unless omitDefaults is on and the value is the default.
+    constexpr bool want(const char* k, bool isDefault) {
+        if (omit_ && isDefault) return false;
+        key(k, isDefault);
+        return true;
+    }
+
+    constexpr void hook(const char* k, bool isDefault) {
+        if constexpr (HasFieldHook<Sink>::value) out_.field(k, isDefault);
+    }
+
+    // Separator before a key or array element: comma, then a line break and
+    // indentation in pretty mode.  A value that follows its key gets neither.
+    constexpr void sep() {
+        if (afterKey_) { afterKey_ = false; return; }
+        if (comma_) out_.put(',');
+        if (indent_ && depth_ > 0) newline();
+        comma_ = false;
+        empty_ = false;
+    }
+
+    constexpr void newline() {
+        out_.put('\r');
+        out_.put('\n');
+        for (unsigned i = 0; i < static_cast<unsigned>(depth_) * indent_; ++i) out_.put(' ');
+    }
+
+    constexpr void quoted(const char* s) {
+        constexpr char hex[] = "0123456789abcdef";
+        out_.put('"');
+        for (; *s; ++s) {
+            const auto c = static_cast<unsigned char>(*s);
+            switch (c) {
+                case '"':  raw("\\\""); break;
+                case '\\': raw("\\\\"); break;
+                case '\b': raw("\\b");  break;
+                case '\f': raw("\\f");  break;
+                case '\n': raw("\\n");  break;
+                case '\r': raw("\\r");  break;
+                case '\t': raw("\\t");  break;
+                default:
+                    if (c < 0x20) {
+                        raw("\\u00");
+                        out_.put(hex[c >> 4]);
+                        out_.put(hex[c & 0x0F]);
+                    } else {
+                        out_.put(static_cast<char>(c));
+                    }
+            }
+        }
+        out_.put('"');
+    }
+
+    constexpr void unsignedDigits(unsigned long long v) {
+        char   tmp[20] = {};
+        size_t n       = 0;
+        do { tmp[n++] = static_cast<char>('0' + v % 10); v /= 10; } while (v);
+        while (n) out_.put(tmp[--n]);
+    }
+
+    constexpr void action(const ActionCfg& a) {
+        // Timer and flags are never configurable here, so always defaults.
+        open('{');
+        if (want(Keys::AutoExecute, true))   boolean(false);
+        if (want(Keys::Binary, true))        boolean(false);
+        key(Keys::EOL);                      str(a.eol  ? a.eol  : "\n");
+        key(Keys::Icon);                     str(a.icon ? a.icon : "");
+        if (want(Keys::TimerInterval, true)) integer(Defaults::TimerInterval);
+        if (want(Keys::TimerMode, true))     integer(Defaults::TimerMode);
+        key(Keys::Title);                    str(a.title  ? a.title  : "");
+        key(Keys::TxData);                   str(a.txData ? a.txData : "");
+        close('}');
+    }
+
+    Sink&   out_;
+    uint8_t indent_   = 0;
+    uint8_t depth_    = 0;
+    bool    comma_    = false;   ///< A value precedes; next element needs ','
+    bool    empty_    = true;    ///< Innermost open container has no elements
+    bool    afterKey_ = false;   ///< Next value belongs to the key just written
+    bool    omit_     = false;   ///< DashboardCfg::omitDefaults
+};
+
+// ─── Compile-time project frame ──────────────────────────────────────────────
+
+/** Bitwise CRC for constant evaluation; matches FrameCrc bit for bit. */
+constexpr uint32_t constexprCrc(Checksum algo, const char* p, size_t n) {
+    uint32_t crc = algo == Checksum::Crc16 ? 0xFFFFu :
+                   algo == Checksum::Crc32 ? 0xFFFFFFFFu : 0u;
+    for (size_t i = 0; i < n; ++i) {
+        const auto byte = static_cast<uint8_t>(p[i]);
+        switch (algo) {
+            case Checksum::Crc8:
+                crc ^= byte;
+                for (int b = 0; b < 8; ++b) crc = ((crc << 1) ^ ((crc & 0x80u) ? 0x07u : 0u)) & 0xFFu;
+                break;
+            case Checksum::Crc16:
+                crc ^= static_cast<uint32_t>(byte) << 8;
+                for (int b = 0; b < 8; ++b) crc = ((crc << 1) ^ ((crc & 0x8000u) ? 0x1021u : 0u)) & 0xFFFFu;
+                break;
+            case Checksum::Crc32:
+                crc ^= byte;
+                for (int b = 0; b < 8; ++b) crc = (crc >> 1) ^ ((crc & 1u) ? 0xEDB88320u : 0u);
+                break;
+            default:
+                break;
+        }
+    }
+    return algo == Checksum::Crc32 ? crc ^ 0xFFFFFFFFu : crc;
+}
+
+// ─── Size bounds ─────────────────────────────────────────────────────────────
+
+/** Length of @p text once escaped as a JSON string body. */
+constexpr size_t escapedLength(const char* text) {
+    size_t n = 0;
+    for (; text && *text; ++text) {
+        const auto c = static_cast<unsigned char>(*text);
+        n += (c == '"' || c == '\\' || c == '\b' || c == '\f' ||
+              c == '\n' || c == '\r' || c == '\t') ? 2 :
+             c < 0x20 ? 6 : 1;
+    }
+    return n;
+}
+
+/**
+ * Longest value text @p ds can carry, in escaped JSON bytes.  Datasets
+ * with neither a telemetryKey nor a struct field never leave their "0"
+ * placeholder; enum datasets reserve room for their longest label (up to
+ * 255 bytes).
+ */
+constexpr uint8_t maxValueWidth(const DatasetCfg& ds) {
+    if ((!ds.telemetryKey || ds.telemetryKey[0] == '\0') &&
+        ds.field.type == FieldType::None) return 1;
+    size_t w = ds.valueWidth > kNumericValueWidth ? ds.valueWidth : kNumericValueWidth;
+    for (uint8_t i = 0; ds.labels && i < ds.labelCount; ++i) {
+        const size_t n = escapedLength(ds.labels[i]);
+        if (n > w) w = n;
+    }
+    return static_cast<uint8_t>(w > 255 ? 255 : w);
+}
+
+/** Bytes the project JSON can grow by once every value is at full width. */
+constexpr size_t maxValueGrowth(const DashboardCfg& cfg) {
+    size_t n = 0;
+    for (uint8_t gi = 0; gi < cfg.groupCount; ++gi) {
+        for (uint8_t di = 0; di < cfg.groups[gi].datasetCount; ++di) {
+            n += maxValueWidth(cfg.groups[gi].datasets[di]) - 1u;
+        }
+    }
+    return n;
+}
+
+/**
+ * Buffer size (including NUL) for one data row of @p fields fields whose
+ * value text totals @p text bytes.
+ */
+constexpr size_t dataRowSize(Decoder decoder, Checksum checksum, size_t fields, size_t text) {
+    size_t payload = 0;
+    switch (decoder) {
+        case Decoder::Hexadecimal: payload = 8 * fields;                  break;
+        case Decoder::Base64:      payload = 4 * ((4 * fields + 2) / 3);  break;
+        default:                   payload = text + (fields ? fields - 1 : 0);
+    }
+    return 2 + payload + 2 + checksumSize(checksum) + 2 + 1;
+}
+
+/** Worst-case buffer size (including NUL) for one data row. */
+constexpr size_t maxDataRowSize(const DashboardCfg& cfg) {
+    size_t fields = 0;
+    size_t text   = 0;
+    for (uint8_t gi = 0; gi < cfg.groupCount; ++gi) {
+        for (uint8_t di = 0; di < cfg.groups[gi].datasetCount; ++di) {
+            ++fields;
+            text += maxValueWidth(cfg.groups[gi].datasets[di]);
+        }
+    }
+    return dataRowSize(cfg.decoder, cfg.checksum, fields, text);
+}
+
+/** Length of the compact project JSON for @p cfg. */
+constexpr size_t projectJsonSize(const DashboardCfg& cfg) {
+    CountingSink  sink;
+    ProjectWriter<CountingSink> w(sink);
+    w.project(cfg);
+    return sink.size;
+}
+
+/** Length of the complete project frame: delimiters, JSON, checksum and CRLF. */
+constexpr size_t projectFrameSize(const DashboardCfg& cfg) {
+    return projectJsonSize(cfg) + 6 + checksumSize(cfg.checksum);
+}
+
+/** Render the project frame for @p cfg; N must be projectFrameSize(cfg). */
+template <size_t N>
+constexpr FixedString<N> renderProjectFrame(const DashboardCfg& cfg) {
+    FixedString<N> f;
+    f.put('/'); f.put('*');
+    ProjectWriter<FixedString<N>> w(f);
+    w.project(cfg);
+
+    const uint32_t crc = constexprCrc(cfg.checksum, f.data + 2, f.size - 2);
+    const uint8_t  len = checksumSize(cfg.checksum);
+    f.put('*'); f.put('/');
+    for (uint8_t i = 0; i < len; ++i) {
+        f.put(static_cast<char>((crc >> (8 * (len - 1 - i))) & 0xFFu));
+    }
+    f.put('\r'); f.put('\n');
+    return f;
+}
+
+// ─── Field cost report ───────────────────────────────────────────────────────
+
+/** Bytes one project key accounts for, summed over every object that has it. */
+struct FieldCost {
+    const char* key;        ///< JSON key, or nullptr for braces, brackets and element commas
+    size_t      bytes;      ///< Comma, quoted key, colon and value
+    uint16_t    count;      ///< Occurrences written
+    uint16_t    defaults;   ///< Occurrences equal to Serial Studio's default
+    size_t      savable;    ///< Bytes omitDefaults would save
+};
+
+/** Sink that attributes every byte to the key it belongs to. */
+class CostSink {
+public:
+    constexpr CostSink(FieldCost* out, size_t cap) : out_(out), cap_(cap) {}
+
+    constexpr void field(const char* key, bool isDefault) {
+        cur_   = find(key);
+        def_   = isDefault && key;
+        first_ = def_;
+        if (cur_ && key) {
+            ++cur_->count;
+            if (isDefault) ++cur_->defaults;
+        }
+    }
+
+    constexpr void put(char c) {
+        ++total_;
+        if (!cur_) return;
+        ++cur_->bytes;
+        if (!def_) return;
+        ++cur_->savable;
+        // The first field of an object has no comma, but dropping it also
+        // drops the comma of the field that follows.
+        if (first_ && c != ',') ++cur_->savable;
+        first_ = false;
+    }
+
+    constexpr void hole(uint8_t) { put('0'); }
+
+    constexpr size_t entries() const { return used_; }
+    constexpr size_t total() const { return total_; }
+
+private:
+    static constexpr bool same(const char* a, const char* b) {
+        if (!a || !b) return a == b;
+        while (*a && *a == *b) { ++a; ++b; }
+        return *a == *b;
+    }
+
+    constexpr FieldCost* find(const char* key) {
+        for (size_t i = 0; i < used_; ++i) {
+            if (same(out_[i].key, key)) return &out_[i];
+        }
+        if (used_ == cap_) return nullptr;   // out of room: bytes go unreported
+        out_[used_] = {key, 0, 0, 0, 0};
+        return &out_[used_++];
+    }
+
+    FieldCost* out_;
+    size_t     cap_;
+    size_t     used_  = 0;
+    size_t     total_ = 0;
+    FieldCost* cur_   = nullptr;
+    bool       def_   = false;
+    bool       first_ = false;   ///< Next byte starts a default field
+};
+
+/**
+ * Per-key byte cost of the compact project JSON for @p cfg, in first-seen
+ * order.  Entries sum to projectJsonSize(cfg) when @p cap is large enough
+ * (48 covers every key the writer emits).  Run it with omitDefaults off to
+ * see what turning it on would save.
+ *
+ * @return Number of entries written to @p out.
+ */
+constexpr size_t projectFieldCosts(const DashboardCfg& cfg, FieldCost* out, size_t cap) {
+    CostSink sink(out, cap);
+    ProjectWriter<CostSink> w(sink);
+    w.project(cfg);
+    return sink.entries();
+}
+
+/**
+ * Project frame for a constexpr DashboardCfg, generated entirely at compile
+ * time and stored in flash.  Byte-identical to Dashboard::serialize() right
+ * after begin().
+ */
+template <const DashboardCfg& Cfg>
+struct StaticProject {
+    static constexpr size_t kJsonSize  = projectJsonSize(Cfg);
+    static constexpr size_t kFrameSize = projectFrameSize(Cfg);   ///< Excluding NUL
+
+    /// Buffer (including NUL) that holds the compact project frame at any
+    /// values, once every dataset is at its maxValueWidth().
+    static constexpr size_t kMaxFrameSize = kFrameSize + maxValueGrowth(Cfg) + 1;
+
+    /// Buffer (including NUL) that holds any single data row.
+    static constexpr size_t kMaxRowSize = maxDataRowSize(Cfg);
+
+    static constexpr FixedString<kFrameSize> kFrame = renderProjectFrame<kFrameSize>(Cfg);
+
+    /** Complete NUL-terminated frame, kFrameSize bytes. */
+    static constexpr const char* frame() { return kFrame.data; }
+
+    /** Project JSON inside the frame, kJsonSize bytes (not NUL-terminated). */
+    static constexpr const char* json() { return kFrame.data + 2; }
+};
+
+} // namespace ss
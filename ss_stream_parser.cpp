@@ -0,0 +1,373 @@
+/**
+ * @file ss_stream_parser.cpp
+ * @brief Incremental telemetry parser — implementation.
+ */
+
+#include "ss_stream_parser.h"
+#include "ss_dashboard.h"
+#include <cstdlib>
+#include <cstring>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+
+namespace ss {
+
+namespace {
+
+bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+int hexDigit(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+} // namespace
+
+// ─── Input ───────────────────────────────────────────────────────────────────
+
+size_t StreamParser::feed(const char* data, size_t len) {
+    if (!data) return 0;
+    const uint32_t before = documents_;
+    for (size_t i = 0; i < len; ++i) {
+        while (!step(data[i])) {}
+    }
+    return documents_ - before;
+}
+
+void StreamParser::reset() {
+    state_     = State::Idle;
+    inKey_     = false;
+    depth_     = 0;
+    arrays_    = 0;
+    muteDepth_ = 0;
+    slot_      = -1;
+    pathLen_   = 0;
+    path_[0]   = '\0';
+}
+
+bool StreamParser::step(char c) {
+    switch (state_) {
+        case State::Idle:
+            if (isSpace(c)) return true;
+            if (c == '{') {
+                push(false);
+                state_ = State::KeyOrEnd;
+                return true;
+            }
+            return fail(c);
+
+        case State::Skip:
+            if (c == '\n') state_ = State::Idle;
+            return true;
+
+        case State::KeyOrEnd:
+            if (c == '}') {
+                pop();
+                return true;
+            }
+            [[fallthrough]];
+        case State::Key:
+            if (isSpace(c)) return true;
+            if (c == '"') {
+                beginKey();
+                return true;
+            }
+            return fail(c);
+
+        case State::Colon:
+            if (isSpace(c)) return true;
+            if (c == ':') {
+                state_ = State::Value;
+                return true;
+            }
+            return fail(c);
+
+        case State::ValueOrEnd:
+            if (c == ']') {
+                pop();
+                return true;
+            }
+            [[fallthrough]];
+        case State::Value:
+            if (isSpace(c)) return true;
+            tokLen_ = 0;
+            if (c == '{' || c == '[') {
+                if (!push(c == '[')) return fail(c);
+                state_ = c == '[' ? State::ValueOrEnd : State::KeyOrEnd;
+                return true;
+            }
+            if (c == '"') {
+                state_ = State::String;
+                return true;
+            }
+            if (c == '-' || (c >= '0' && c <= '9')) {
+                number_ = c == '-' ? NumberPart::Sign
+                        : c == '0' ? NumberPart::Zero : NumberPart::Int;
+                put(c);
+                state_ = State::Number;
+                return true;
+            }
+            literal_ = c == 't' ? "true" : c == 'f' ? "false" : c == 'n' ? "null" : nullptr;
+            if (!literal_) return fail(c);
+            count_ = 1;
+            state_ = State::Literal;
+            return true;
+
+        case State::AfterValue:
+            if (isSpace(c)) return true;
+            if (c == ',') {
+                state_ = inArray() ? State::Value : State::Key;
+                return true;
+            }
+            if (c == (inArray() ? ']' : '}')) {
+                pop();
+                return true;
+            }
+            return fail(c);
+
+        case State::String:
+            if (c == '"') {
+                if (inKey_) endKey();
+                else        endString();
+                return true;
+            }
+            if (c == '\\') {
+                state_ = State::Escape;
+                return true;
+            }
+            if (static_cast<uint8_t>(c) < 0x20) return fail(c);
+            put(c);
+            return true;
+
+        case State::Escape:
+            state_ = State::String;
+            switch (c) {
+                case '"': case '\\': case '/': put(c);    return true;
+                case 'b': put('\b'); return true;
+                case 'f': put('\f'); return true;
+                case 'n': put('\n'); return true;
+                case 'r': put('\r'); return true;
+                case 't': put('\t'); return true;
+                case 'u':
+                    hex_   = 0;
+                    count_ = 0;
+                    state_ = State::Unicode;
+                    return true;
+                default:
+                    return fail(c);
+            }
+
+        case State::Unicode: {
+            const int d = hexDigit(c);
+            if (d < 0) return fail(c);
+            hex_ = static_cast<uint16_t>((hex_ << 4) | d);
+            if (++count_ == 4) {
+                putCodePoint(hex_);
+                state_ = State::String;
+            }
+            return true;
+        }
+
+        case State::Number:
+            if ((c >= '0' && c <= '9') || c == '.' || c == 'e' || c == 'E' ||
+                c == '+' || c == '-') {
+                if (!numberChar(c)) return fail(c);
+                put(c);
+                return true;
+            }
+            if (!numberComplete()) return fail(c);
+            endNumber();
+            return false;   // the terminator belongs to whatever follows
+
+        case State::Literal:
+            if (c != literal_[count_]) return fail(c);
+            if (literal_[++count_] == '\0') endLiteral();
+            return true;
+    }
+    return true;
+}
+
+// ─── Structure ───────────────────────────────────────────────────────────────
+
+bool StreamParser::inArray() const {
+    return depth_ > 0 && ((arrays_ >> (depth_ - 1)) & 1u);
+}
+
+bool StreamParser::push(bool array) {
+    if (depth_ == kMaxDepth) return false;
+    if (array) {
+        arrays_ = static_cast<uint8_t>(arrays_ | (1u << depth_));
+        if (muteDepth_ == 0) muteDepth_ = depth_ + 1;   // dotted keys stop here
+    } else {
+        arrays_ = static_cast<uint8_t>(arrays_ & ~(1u << depth_));
+    }
+    mark_[depth_] = pathLen_;
+    ++depth_;
+    slot_ = -1;
+    return true;
+}
+
+void StreamParser::pop() {
+    --depth_;
+    if (muteDepth_ > depth_) muteDepth_ = 0;
+    if (depth_ == 0) {
+        ++documents_;
+        reset();
+        return;
+    }
+    endValue();
+}
+
+void StreamParser::beginKey() {
+    // A member name replaces the previous sibling's, so the path goes back
+    // to where this object started.
+    if (muteDepth_ == depth_) muteDepth_ = 0;
+    pathLen_ = mark_[depth_ - 1];
+    inKey_   = true;
+    state_   = State::String;
+    if (pathLen_ > 0) put('.');
+}
+
+void StreamParser::endKey() {
+    path_[pathLen_] = '\0';
+    inKey_ = false;
+    slot_  = muteDepth_ == 0 ? dash_.findSlot(path_) : -1;
+    state_ = State::Colon;
+}
+
+// ─── Values ──────────────────────────────────────────────────────────────────
+
+void StreamParser::put(char c) {
+    if (inKey_) {
+        if (pathLen_ < kMaxPath) {
+            path_[pathLen_++] = c;
+        } else if (muteDepth_ == 0) {
+            muteDepth_ = depth_;   // path too long to match anything
+        }
+        return;
+    }
+    // Values nothing listens to are scanned but not kept.
+    if (slot_ >= 0 && tokLen_ < kMaxToken) tok_[tokLen_++] = c;
+}
+
+void StreamParser::putCodePoint(uint16_t cp) {
+    if (cp < 0x80) {
+        put(static_cast<char>(cp));
+    } else if (cp < 0x800) {
+        put(static_cast<char>(0xC0 | (cp >> 6)));
+        put(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else {
+        put(static_cast<char>(0xE0 | (cp >> 12)));
+        put(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+        put(static_cast<char>(0x80 | (cp & 0x3F)));
+    }
+}
+
+bool StreamParser::numberChar(char c) {
+    const bool digit = c >= '0' && c <= '9';
+    const bool exp   = c == 'e' || c == 'E';
+    switch (number_) {
+        case NumberPart::Sign:
+            if (!digit) return false;
+            number_ = c == '0' ? NumberPart::Zero : NumberPart::Int;
+            return true;
+        case NumberPart::Zero:
+        case NumberPart::Int:
+            if (digit) return number_ == NumberPart::Int;
+            if (c == '.') number_ = NumberPart::Point;
+            else if (exp) number_ = NumberPart::Exp;
+            else return false;
+            return true;
+        case NumberPart::Point:
+            if (!digit) return false;
+            number_ = NumberPart::Frac;
+            return true;
+        case NumberPart::Frac:
+            if (digit) return true;
+            if (!exp) return false;
+            number_ = NumberPart::Exp;
+            return true;
+        case NumberPart::Exp:
+            if (c == '+' || c == '-') {
+                number_ = NumberPart::ExpSign;
+                return true;
+            }
+            [[fallthrough]];
+        case NumberPart::ExpSign:
+            if (!digit) return false;
+            number_ = NumberPart::ExpInt;
+            return true;
+        case NumberPart::ExpInt:
+            return digit;
+    }
+    return false;
+}
+
+bool StreamParser::numberComplete() const {
+    return number_ == NumberPart::Zero || number_ == NumberPart::Int ||
+           number_ == NumberPart::Frac || number_ == NumberPart::ExpInt;
+}
+
+void StreamParser::endString() {
+    if (slot_ >= 0) {
+        tok_[tokLen_] = '\0';
+        dash_.setText(static_cast<uint8_t>(slot_), tok_);
+    }
+    endValue();
+}
+
+void StreamParser::endNumber() {
+    if (slot_ >= 0) {
+        tok_[tokLen_] = '\0';
+        const auto slot = static_cast<uint8_t>(slot_);
+        char*      end  = nullptr;
+
+        // Integers that fit go through the exact integer path, like an
+        // integer leaf in update(); everything else is a float.
+        const bool integral = tokLen_ <= 18 && strpbrk(tok_, ".eE") == nullptr;
+        if (integral) {
+            const long long v = strtoll(tok_, &end, 10);
+            if (end == tok_ + tokLen_) dash_.set(slot, static_cast<int64_t>(v));
+        } else {
+            const float v = strtof(tok_, &end);
+            if (end == tok_ + tokLen_) dash_.setValue(slot, v);
+        }
+        if (end != tok_ + tokLen_) {
+            fail(tok_[0]);
+            return;
+        }
+    }
+    endValue();
+}
+
+void StreamParser::endLiteral() {
+    // Booleans are numeric 0 / 1, as in update(); null leaves the value alone.
+    if (slot_ >= 0 && literal_[0] != 'n') {
+        dash_.setValue(static_cast<uint8_t>(slot_), literal_[0] == 't' ? 1.0f : 0.0f);
+    }
+    endValue();
+}
+
+void StreamParser::endValue() {
+    slot_  = -1;
+    state_ = State::AfterValue;
+}
+
+bool StreamParser::fail(char c) {
+    ++errors_;
+#ifdef ARDUINO
+    Serial.printf("[ss] stream: malformed telemetry at depth %u, skipping line\n",
+                  depth_);
+#endif
+    reset();
+    state_ = State::Skip;
+    return c != '\n';   // a newline both ends the error and is handled again
+}
+
+} // namespace ss
@@ -0,0 +1,145 @@
+/**
+ * @file ss_stream_parser.h
+ * @brief Incremental telemetry parser that feeds a Dashboard without a DOM.
+ *
+ * Dashboard::update() and ingest() both materialise a JsonDocument before a
+ * single value is patched.  StreamParser instead consumes telemetry bytes as
+ * they arrive from a UART or socket, tracks the dotted path of the member it
+ * is in, and hands each scalar whose path is a slot's telemetryKey straight
+ * to Dashboard::setValue() / setText().  Memory is the parser object itself,
+ * whatever the document size, and a document may be split across any
+ * number of feed() calls.
+ *
+ * @code
+ *   ss::StreamParser parser(dashboard);
+ *
+ *   void loop() {
+ *       char buf[128];
+ *       const size_t n = Serial1.readBytes(buf, sizeof(buf));
+ *       parser.feed(buf, n);
+ *       ...
+ *   }
+ * @endcode
+ *
+ * The input is a stream of JSON objects, separated by optional whitespace
+ * (newline-delimited JSON works as-is).  Values are applied as soon as they
+ * are complete, so a document that turns out to be malformed halfway has
+ * already updated the slots before the error; the parser then discards
+ * input up to the next newline and starts over.  Every number is checked
+ * against the JSON grammar, matched or not, so "1.2.3" or "01" is an error
+ * wherever it appears.  Like update(), it follows
+ * object members only — anything inside an array is skipped.  Works in both
+ * build profiles.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ss {
+
+class Dashboard;
+
+class StreamParser {
+public:
+    /// Deepest object / array nesting accepted; deeper input is an error.
+    static constexpr uint8_t kMaxDepth = 8;
+
+    /// Longest dotted path tracked; members below a longer path are skipped.
+    static constexpr uint8_t kMaxPath = 64;
+
+    /// Longest number or string value kept; longer strings are truncated.
+    static constexpr uint8_t kMaxToken = 64;
+
+    /** @param dashboard  Receives the values; must outlive the parser. */
+    explicit StreamParser(Dashboard& dashboard) : dash_(dashboard) {}
+
+    /**
+     * Consume the next @p len bytes of the stream.
+     *
+     * @return Number of documents completed within these bytes.
+     */
+    size_t feed(const char* data, size_t len);
+
+    /** Drop any partly parsed document and wait for the next '{'. */
+    void reset();
+
+    /** Documents completed since construction. */
+    uint32_t documents() const { return documents_; }
+
+    /** Malformed documents skipped since construction. */
+    uint32_t errors() const { return errors_; }
+
+private:
+    enum class State : uint8_t {
+        Idle,           ///< Between documents, waiting for '{'
+        Value,          ///< After ':' or ','-in-array
+        KeyOrEnd,       ///< After '{'
+        Key,            ///< After ',' in an object
+        Colon,          ///< After a member name
+        ValueOrEnd,     ///< After '['
+        AfterValue,     ///< ',' or a closing bracket
+        String,
+        Escape,
+        Unicode,        ///< Reading the four hex digits of \uXXXX
+        Number,
+        Literal,        ///< true / false / null
+        Skip            ///< Discarding input up to the next newline
+    };
+
+    /// Where a number token is in the JSON number grammar.
+    enum class NumberPart : uint8_t {
+        Sign,           ///< After '-'
+        Zero,           ///< Leading '0'; only '.', 'e' or the end may follow
+        Int,
+        Point,          ///< After '.'
+        Frac,
+        Exp,            ///< After 'e' / 'E'
+        ExpSign,        ///< After the exponent's '+' / '-'
+        ExpInt
+    };
+
+    /** Handle one byte.  Returns false if it must be handled again. */
+    bool step(char c);
+
+    bool inArray() const;
+    bool push(bool array);
+    void pop();
+    void beginKey();
+    void endKey();
+    void put(char c);
+    void putCodePoint(uint16_t cp);
+    bool numberChar(char c);
+    bool numberComplete() const;
+    void endString();
+    void endNumber();
+    void endLiteral();
+    void endValue();
+    bool fail(char c);
+
+    Dashboard& dash_;
+
+    State    state_     = State::Idle;
+    bool     inKey_     = false;
+    uint8_t  depth_     = 0;
+    uint8_t  arrays_    = 0;            ///< Bit d set: level d + 1 is an array
+    uint8_t  muteDepth_ = 0;            ///< Shallowest level not matched (0 = none)
+    uint8_t  mark_[kMaxDepth] = {};     ///< Path length at each object's start
+    int      slot_      = -1;           ///< Slot of the pending value, or -1
+
+    char     path_[kMaxPath + 1] = {};
+    uint8_t  pathLen_   = 0;
+
+    char     tok_[kMaxToken + 1] = {};
+    uint8_t  tokLen_    = 0;
+    uint8_t  count_     = 0;            ///< Hex digits / literal letters read
+    uint16_t hex_       = 0;
+    const char* literal_ = nullptr;     ///< "true", "false" or "null"
+    NumberPart  number_  = NumberPart::Int;
+
+    uint32_t documents_ = 0;
+    uint32_t errors_    = 0;
+};
+
+} // namespace ss
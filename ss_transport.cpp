@@ -0,0 +1,177 @@
+/**
+ * @file ss_transport.cpp
+ * @brief Transport-side helpers for streaming Serial Studio frames — implementation.
+ */
+
+#include "ss_transport.h"
+#include <cstring>
+
+namespace ss {
+
+// ─── FrameCoalescer ──────────────────────────────────────────────────────────
+
+FrameCoalescer::FrameCoalescer(const CoalescerCfg& cfg, SinkFn sink, void* ctx)
+    : cfg_(cfg), sink_(sink), ctx_(ctx)
+{
+    if (cfg_.mtu == 0 || cfg_.mtu > kMaxSegment) cfg_.mtu = kMaxSegment;
+}
+
+size_t FrameCoalescer::push(const char* frame, size_t len, uint32_t nowMs) {
+    if (!frame || len == 0) return 0;
+
+    // A frame that fits in one segment but not alongside the pending bytes
+    // closes the current segment, so small frames never straddle two.  If
+    // the link cannot take it, nothing of this frame is queued.
+    if (len <= cfg_.mtu && len_ + len > cfg_.mtu && !flush()) return 0;
+
+    // Larger frames fill segment after segment.  Every piece goes through
+    // flush(), which keeps whatever the sink did not take.
+    size_t taken = 0;
+    while (taken < len) {
+        if (len_ == cfg_.mtu && !flush()) break;
+        const size_t room = cfg_.mtu - len_;
+        const size_t n    = len - taken < room ? len - taken : room;
+        if (len_ == 0) firstMs_ = nowMs;
+        memcpy(seg_ + len_, frame + taken, n);
+        len_  += n;
+        taken += n;
+    }
+    if (taken == len) ++framesIn_;
+
+    if (len_ >= cfg_.mtu) {
+        flush();
+    } else {
+        poll(nowMs);
+    }
+    return taken;
+}
+
+bool FrameCoalescer::poll(uint32_t nowMs) {
+    if (len_ == 0) return false;
+    if (nowMs - firstMs_ < cfg_.flushDeadlineMs) return false;
+    return flush();
+}
+
+bool FrameCoalescer::flush() {
+    if (len_ == 0) return true;
+    if (!sink_) return false;
+
+    const size_t sent = sink_(ctx_, seg_, len_);
+    ++segmentsOut_;
+    if (sent >= len_) {
+        len_ = 0;
+        return true;
+    }
+
+    // Keep the unsent tail at the front of the segment for the next attempt.
+    memmove(seg_, seg_ + sent, len_ - sent);
+    len_ -= sent;
+    return false;
+}
+
+// ─── RateController ──────────────────────────────────────────────────────────
+
+RateController::RateController(const RateControllerCfg& cfg,
+                               uint32_t initialIntervalMs)
+    : cfg_(cfg), intervalMs_(initialIntervalMs)
+{
+    if (cfg_.targetUtilPct == 0 || cfg_.targetUtilPct > 100) cfg_.targetUtilPct = 100;
+    if (cfg_.smoothingPct == 0 || cfg_.smoothingPct > 100)   cfg_.smoothingPct  = 100;
+    if (cfg_.maxIntervalMs < cfg_.minIntervalMs) cfg_.maxIntervalMs = cfg_.minIntervalMs;
+}
+
+void RateController::recordFrame(size_t bytes, uint32_t drainUs) {
+    recordWrite(bytes, drainUs);
+    updateInterval(static_cast<float>(drainUs == 0 ? 1 : drainUs));
+}
+
+void RateController::recordFrame(size_t bytes) {
+    if (!primed_ || bps_ <= 0.0f) return;
+    updateInterval(static_cast<float>(bytes) * 1e6f / bps_);
+}
+
+void RateController::recordWrite(size_t bytes, uint32_t drainUs) {
+    if (drainUs == 0) drainUs = 1;
+    const float sampleBps = static_cast<float>(bytes) * 1e6f / static_cast<float>(drainUs);
+
+    if (!primed_) {
+        bps_    = sampleBps;
+        primed_ = true;
+    } else {
+        bps_ += cfg_.smoothingPct / 100.0f * (sampleBps - bps_);
+    }
+}
+
+void RateController::updateInterval(float drainUs) {
+    if (!framed_) {
+        drainUs_ = drainUs;
+        framed_  = true;
+    } else {
+        drainUs_ += cfg_.smoothingPct / 100.0f * (drainUs - drainUs_);
+    }
+
+    // A frame that drains in D at utilisation U needs an interval of D / U.
+    const float ideal = drainUs_ / (10.0f * cfg_.targetUtilPct);   // µs → ms, / (U%)
+    uint32_t next = static_cast<uint32_t>(ideal + 0.5f);
+    if (next < cfg_.minIntervalMs) next = cfg_.minIntervalMs;
+    if (next > cfg_.maxIntervalMs) next = cfg_.maxIntervalMs;
+    intervalMs_ = next;
+}
+
+bool RateController::due(uint32_t nowMs) {
+    if (nowMs - lastDueMs_ < intervalMs_) return false;
+    lastDueMs_ = nowMs;
+    return true;
+}
+
+uint8_t RateController::utilisationPct() const {
+    const float pct = drainUs_ / (10.0f * static_cast<float>(intervalMs_));
+    return static_cast<uint8_t>(pct > 100.0f ? 100.0f : pct);
+}
+
+// ─── ProjectHandshake ────────────────────────────────────────────────────────
+
+ProjectHandshake::ProjectHandshake(const HandshakeCfg& cfg)
+    : cfg_(cfg)
+{}
+
+int ProjectHandshake::find(uint32_t clientId) const {
+    for (uint8_t i = 0; i < kMaxClients; ++i) {
+        if (clients_[i].used && clients_[i].id == clientId) return i;
+    }
+    return -1;
+}
+
+bool ProjectHandshake::needsProject(uint32_t clientId, uint32_t layoutHash,
+                                    uint32_t nowMs) const {
+    const int i = find(clientId);
+    if (i < 0 || clients_[i].hash != layoutHash) return true;
+    return cfg_.rememberMs != 0 && nowMs - clients_[i].sentMs >= cfg_.rememberMs;
+}
+
+void ProjectHandshake::projectSent(uint32_t clientId, uint32_t layoutHash,
+                                   uint32_t nowMs) {
+    // Same client, else a free entry, else the one served longest ago.
+    int i = find(clientId);
+    for (uint8_t j = 0; i < 0 && j < kMaxClients; ++j) {
+        if (!clients_[j].used) i = j;
+    }
+    if (i < 0) {
+        i = 0;
+        for (uint8_t j = 1; j < kMaxClients; ++j) {
+            if (nowMs - clients_[j].sentMs > nowMs - clients_[i].sentMs) i = j;
+        }
+    }
+    clients_[i] = {clientId, layoutHash, nowMs, true};
+}
+
+void ProjectHandshake::forget(uint32_t clientId) {
+    const int i = find(clientId);
+    if (i >= 0) clients_[i].used = false;
+}
+
+void ProjectHandshake::clear() {
+    for (auto& c : clients_) c.used = false;
+}
+
+} // namespace ss
@@ -0,0 +1,267 @@
+/**
+ * @file ss_transport.h
+ * @brief Transport-side helpers for streaming Serial Studio frames.
+ *
+ * The Dashboard itself never touches a socket or UART.  The helpers in this
+ * header sit between serialize() and whatever link the caller owns, and deal
+ * with the cost of the link rather than the content of the frame.
+ *
+ * FrameCoalescer packs several small frames into one MTU-sized segment so a
+ * high-rate stream pays for one TCP/UDP header (and one ACK) per segment
+ * instead of per frame.  A segment is flushed as soon as it is full, or once
+ * the oldest frame in it has waited flushDeadlineMs — whichever comes first.
+ * Frames larger than a segment are streamed through it in MTU-sized pieces,
+ * so a short write never leaves a truncated frame behind.
+ *
+ * RateController measures how long each frame takes to drain through the
+ * link and picks the emit interval that keeps the link at a target
+ * utilisation, so the same firmware runs at a sensible rate on a 115200-baud
+ * UART and on WiFi without hand tuning.
+ *
+ * ProjectHandshake remembers which layout (Dashboard::layoutHash()) each
+ * client last received, so a client that reconnects to an unchanged layout
+ * gets data frames only instead of another full project.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ss {
+
+// ─── Frame coalescing ────────────────────────────────────────────────────────
+
+/** Configuration for a FrameCoalescer. */
+struct CoalescerCfg {
+    uint16_t mtu             = 1460;  ///< Segment payload size (Ethernet/WiFi TCP MSS)
+    uint16_t flushDeadlineMs = 5;     ///< Longest time a frame may sit in a segment
+    bool     noDelay         = true;  ///< Disable Nagle on the socket (TCP_NODELAY)
+};
+
+class FrameCoalescer {
+public:
+    /// Largest segment the coalescer can hold; cfg.mtu is clamped to this.
+    static constexpr uint16_t kMaxSegment = 1460;
+
+    /**
+     * Segment sink.  Called with at most cfg.mtu bytes at a time.
+     *
+     * @return Bytes accepted by the link.  Anything short of @p len stays
+     *         queued and is retried on the next flush.
+     */
+    using SinkFn = size_t (*)(void* ctx, const char* data, size_t len);
+
+    /**
+     * @param cfg   Coalescing parameters (copied).
+     * @param sink  Segment sink — typically a socket write.
+     * @param ctx   Opaque pointer forwarded to @p sink.
+     */
+    FrameCoalescer(const CoalescerCfg& cfg, SinkFn sink, void* ctx);
+
+    /**
+     * Queue one frame.  Flushes first if the frame would not fit in the
+     * current segment, and again afterwards if the segment is full or its
+     * deadline has passed.  A frame that fits in one segment is taken whole
+     * or not at all.  A larger frame fills segment after segment; if the
+     * sink stops taking data part-way, the bytes already queued stay queued
+     * and the rest is left to the caller.
+     *
+     * @code
+     *   size_t sent = 0;
+     *   while (sent < len) sent += coalescer.push(txBuf + sent, len - sent, millis());
+     * @endcode
+     *
+     * @param frame  Frame bytes (e.g. the output of Dashboard::serialize()).
+     * @param len    Frame length in bytes.
+     * @param nowMs  Current time in milliseconds (e.g. millis()).
+     * @return       Bytes of @p frame accepted.  Less than @p len when the
+     *               sink is backed up; push the remainder again later.
+     */
+    size_t push(const char* frame, size_t len, uint32_t nowMs);
+
+    /**
+     * Flush the pending segment if its deadline has elapsed.  Call this from
+     * the transmit loop so a lone frame never waits longer than
+     * flushDeadlineMs for company.
+     *
+     * @return true if a flush was attempted and fully succeeded.
+     */
+    bool poll(uint32_t nowMs);
+
+    /**
+     * Hand the pending segment to the sink immediately.
+     *
+     * @return true if the segment was fully written (or nothing was pending).
+     */
+    bool flush();
+
+    /**
+     * Drop the pending bytes without sending them, e.g. when the link they
+     * were queued for has closed.  A partial frame left over from the old
+     * link would otherwise be the first thing the next one receives.
+     */
+    void reset() { len_ = 0; }
+
+    /** Bytes currently waiting in the segment buffer. */
+    size_t pending() const { return len_; }
+
+    /** Frames accepted by push() since construction. */
+    uint32_t framesIn() const { return framesIn_; }
+
+    /** Segments (sink calls) emitted since construction. */
+    uint32_t segmentsOut() const { return segmentsOut_; }
+
+    const CoalescerCfg& cfg() const { return cfg_; }
+
+private:
+    CoalescerCfg cfg_;
+    SinkFn       sink_;
+    void*        ctx_;
+
+    char     seg_[kMaxSegment];
+    size_t   len_         = 0;
+    uint32_t firstMs_     = 0;   ///< Arrival time of the oldest pending frame
+    uint32_t framesIn_    = 0;
+    uint32_t segmentsOut_ = 0;
+};
+
+// ─── Adaptive frame rate ─────────────────────────────────────────────────────
+
+/** Configuration for a RateController. */
+struct RateControllerCfg {
+    uint32_t minIntervalMs = 10;     ///< Fastest emit interval allowed
+    uint32_t maxIntervalMs = 5000;   ///< Slowest emit interval allowed
+    uint8_t  targetUtilPct = 70;     ///< Share of link time frames may occupy
+    uint8_t  smoothingPct  = 25;     ///< Weight of each new measurement (EWMA)
+};
+
+class RateController {
+public:
+    /**
+     * @param cfg                Controller limits (copied).
+     * @param initialIntervalMs  Interval used until the first measurement
+     *                           (e.g. the old hard-coded kBroadcastMs).
+     */
+    RateController(const RateControllerCfg& cfg, uint32_t initialIntervalMs);
+
+    /**
+     * Report one frame that has been handed to the link.
+     *
+     * @param bytes    Frame size.
+     * @param drainUs  Time the transport took to accept / transmit it
+     *                 (e.g. micros() around Serial.write() + flush(), or
+     *                 around a chunked TCP send).
+     */
+    void recordFrame(size_t bytes, uint32_t drainUs);
+
+    /**
+     * Report one frame whose drain time was not measured directly, e.g.
+     * because a FrameCoalescer split or merged it before it reached the
+     * link.  The drain time is estimated from throughputBps(); the call is
+     * ignored until recordWrite() or recordFrame(bytes, drainUs) has
+     * measured the link once.
+     *
+     * @param bytes  Frame size.
+     */
+    void recordFrame(size_t bytes);
+
+    /**
+     * Report one timed write to the link (e.g. micros() around the sends in a
+     * coalescer sink).  Updates throughputBps() only; the interval follows
+     * when frames are reported with recordFrame(bytes).
+     *
+     * @param bytes    Bytes written.
+     * @param drainUs  Time the transport took to accept / transmit them.
+     */
+    void recordWrite(size_t bytes, uint32_t drainUs);
+
+    /**
+     * Convenience scheduler: true if at least intervalMs() has passed since
+     * the last time this returned true.
+     */
+    bool due(uint32_t nowMs);
+
+    /** Emit interval currently chosen by the controller. */
+    uint32_t intervalMs() const { return intervalMs_; }
+
+    /** Frame rate implied by intervalMs(), for display. */
+    float framesPerSecond() const { return 1000.0f / static_cast<float>(intervalMs_); }
+
+    /** Smoothed link throughput in bytes/s (0 until the first frame). */
+    uint32_t throughputBps() const { return static_cast<uint32_t>(bps_); }
+
+    /** Smoothed per-frame drain time in microseconds. */
+    uint32_t drainUs() const { return static_cast<uint32_t>(drainUs_); }
+
+    /** Share of the current interval spent draining frames, in percent. */
+    uint8_t utilisationPct() const;
+
+private:
+    /** Fold one per-frame drain time into the average and re-derive the interval. */
+    void updateInterval(float drainUs);
+
+    RateControllerCfg cfg_;
+    uint32_t intervalMs_;
+    uint32_t lastDueMs_ = 0;
+    bool     primed_    = false;   ///< Link throughput measured at least once
+    bool     framed_    = false;   ///< At least one frame drain time known
+    float    drainUs_   = 0.0f;
+    float    bps_       = 0.0f;
+};
+
+// ─── Project handshake ───────────────────────────────────────────────────────
+
+/** Configuration for a ProjectHandshake. */
+struct HandshakeCfg {
+    uint32_t rememberMs = 600000;   ///< Resend the project after this long anyway (0 = never)
+};
+
+class ProjectHandshake {
+public:
+    /// Clients remembered at once; the one served longest ago is evicted.
+    static constexpr uint8_t kMaxClients = 8;
+
+    /** @param cfg  Handshake parameters (copied). */
+    explicit ProjectHandshake(const HandshakeCfg& cfg);
+
+    /**
+     * True if @p clientId should get the full project frame: it has never
+     * received one, the layout changed since (@p layoutHash differs), or
+     * rememberMs has passed.  Otherwise data frames are enough.
+     *
+     * @param clientId    Stable client identity that survives reconnects and
+     *                    names one client only.  A MAC or an id the client
+     *                    announces is safe; an IPv4 address is not when
+     *                    clients may share one (NAT, a proxy), because they
+     *                    would share one entry and one of them could be
+     *                    marked served without having the project.
+     * @param layoutHash  Dashboard::layoutHash().
+     */
+    bool needsProject(uint32_t clientId, uint32_t layoutHash, uint32_t nowMs) const;
+
+    /** Record that @p clientId has been sent the project for @p layoutHash. */
+    void projectSent(uint32_t clientId, uint32_t layoutHash, uint32_t nowMs);
+
+    /** Drop what is known about @p clientId (e.g. it reported an error). */
+    void forget(uint32_t clientId);
+
+    /** Drop every client. */
+    void clear();
+
+private:
+    struct Client {
+        uint32_t id;
+        uint32_t hash;
+        uint32_t sentMs;
+        bool     used;
+    };
+
+    /** Index of @p clientId in clients_, or -1. */
+    int find(uint32_t clientId) const;
+
+    HandshakeCfg cfg_;
+    Client       clients_[kMaxClients] = {};
+};
+
+} // namespace ss
@@ -16,10 +16,15 @@
 #include <ArduinoJson.h>
 #include "ss_dashboard.h"
 #include "ss_dashboard_config.h"
+#include "ss_transport.h"
+#include "ss_checksum.h"
+#include "ss_project_writer.h"
+#include "ss_layout_image.h"
+#include "ss_stream_parser.h"
 
 // ─── Minimal test configuration ─────────────────────────────────────────────
 
-static const ss::DatasetCfg kTestDatasets[] = {
+static constexpr ss::DatasetCfg kTestDatasets[] = {
     {
         .title        = "Temp K",
         .units        = "K",
@@ -40,7 +45,7 @@ static const ss::DatasetCfg kTestDatasets[] = {
     },
 };
 
-static const ss::GroupCfg kTestGroups[] = {
+static constexpr ss::GroupCfg kTestGroups[] = {
     {
         .title        = "Test Group",
         .widget       = ss::GroupWidget::Multiplot,
@@ -49,11 +54,11 @@ static const ss::GroupCfg kTestGroups[] = {
     },
 };
 
-static const ss::ActionCfg kTestActions[] = {
+static constexpr ss::ActionCfg kTestActions[] = {
     { .title = "Go", .txData = "go", .icon = "Play", .eol = "\n" },
 };
 
-static const ss::DashboardCfg kTestCfg = {
+static constexpr ss::DashboardCfg kTestCfg = {
     .title       = "Test Dashboard",
     .groups      = kTestGroups,
     .groupCount  = 1,
@@ -61,6 +66,124 @@ static const ss::DashboardCfg kTestCfg = {
     .actionCount = 1,
 };
 
+static const ss::DatasetCfg kFftDatasets[] = {
+    { .title = "Vibration", .telemetryKey = "vib",
+      .fft = true, .fftSamples = 16, .fftSamplingRate = 1000 },
+    { .title = "Temp", .telemetryKey = "temp" },
+};
+
+static const ss::GroupCfg kFftGroups[] = {
+    { .title = "Pump", .datasets = kFftDatasets, .datasetCount = 2 },
+};
+
+static const ss::DashboardCfg kFftCfg = {
+    .title      = "FFT Dashboard",
+    .groups     = kFftGroups,
+    .groupCount = 1,
+};
+
+static const ss::DatasetCfg kAggDatasets[] = {
+    { .title = "Current", .telemetryKey = "i",   .aggregate = ss::Aggregate::Max },
+    { .title = "Voltage", .telemetryKey = "v",   .aggregate = ss::Aggregate::Mean },
+    { .title = "Noise",   .telemetryKey = "n",   .aggregate = ss::Aggregate::Rms },
+    { .title = "Shock",   .telemetryKey = "p",   .aggregate = ss::Aggregate::PeakHold },
+};
+
+static const ss::GroupCfg kAggGroups[] = {
+    { .title = "Power", .datasets = kAggDatasets, .datasetCount = 4 },
+};
+
+static const ss::DashboardCfg kAggCfg = {
+    .title      = "Aggregates",
+    .groups     = kAggGroups,
+    .groupCount = 1,
+};
+
+static const ss::DatasetCfg kAlarmDatasets[] = {
+    { .title = "Pressure", .telemetryKey = "bar",
+      .alarmLow = 10, .alarmHigh = 90, .alarmEnabled = true,
+      .alarmHysteresis = 5, .alarmImmediate = true },
+};
+
+static const ss::GroupCfg kAlarmGroups[] = {
+    { .title = "Line", .datasets = kAlarmDatasets, .datasetCount = 1 },
+};
+
+static const ss::DashboardCfg kAlarmCfg = {
+    .title      = "Alarms",
+    .groups     = kAlarmGroups,
+    .groupCount = 1,
+};
+
+static const ss::DatasetCfg kSchedDatasets[] = {
+    { .title = "Loop",   .telemetryKey = "c",  .priority = ss::Priority::Critical },
+    { .title = "Half",   .telemetryKey = "n2", .updateEvery = 2 },
+    { .title = "10 Hz",  .telemetryKey = "r",  .maxRateHz = 10 },
+    { .title = "Uptime", .telemetryKey = "h1", .priority = ss::Priority::Housekeeping },
+    { .title = "Heap",   .telemetryKey = "h2", .priority = ss::Priority::Housekeeping },
+};
+
+static const ss::GroupCfg kSchedGroups[] = {
+    { .title = "Sched", .datasets = kSchedDatasets, .datasetCount = 5 },
+};
+
+static const ss::DashboardCfg kSchedCfg = {
+    .title      = "Scheduler",
+    .groups     = kSchedGroups,
+    .groupCount = 1,
+};
+
+static constexpr ss::DashboardCfg kLeanCfg = {
+    .title        = "Test Dashboard",
+    .groups       = kTestGroups,
+    .groupCount   = 1,
+    .actions      = kTestActions,
+    .actionCount  = 1,
+    .omitDefaults = true,
+};
+
+// A hot-plugged sensor module, and the config it would make if built in.
+static constexpr ss::DatasetCfg kModuleDatasets[] = {
+    { .title = "Humidity", .units = "%", .telemetryKey = "module.rh" },
+};
+
+static constexpr ss::GroupCfg kModuleGroup = {
+    .title        = "Module",
+    .datasets     = kModuleDatasets,
+    .datasetCount = 1,
+};
+
+static constexpr ss::GroupCfg kPluggedGroups[] = { kTestGroups[0], kModuleGroup };
+
+static constexpr ss::DashboardCfg kPluggedCfg = {
+    .title       = "Test Dashboard",
+    .groups      = kPluggedGroups,
+    .groupCount  = 2,
+    .actions     = kTestActions,
+    .actionCount = 1,
+};
+
+static constexpr ss::DashboardCfg kCrcCfg = {
+    .title      = "Checked",
+    .groups     = kTestGroups,
+    .groupCount = 1,
+    .checksum   = ss::Checksum::Crc16,
+};
+
+static const ss::DashboardCfg kHexCfg = {
+    .title      = "Hex",
+    .groups     = kTestGroups,
+    .groupCount = 1,
+    .decoder    = ss::Decoder::Hexadecimal,
+};
+
+static constexpr ss::DashboardCfg kBase64Cfg = {
+    .title      = "Base64",
+    .groups     = kTestGroups,
+    .groupCount = 1,
+    .decoder    = ss::Decoder::Base64,
+};
+
 // ─── Tests ───────────────────────────────────────────────────────────────────
 
 void test_dashboard_begin_creates_valid_json(void) {
@@ -272,6 +395,1618 @@ void test_dashboard_serialize_pretty_is_valid_json(void) {
     TEST_ASSERT_NOT_NULL(doc["title"].as<const char*>());
 }
 
+void test_dashboard_serialize_data_row(void) {
+    ss::Dashboard dash(kTestCfg);
+    dash.begin();
+
+    JsonDocument telemetry;
+    telemetry["temperature"]["k"] = 78.45f;
+    telemetry["state"]["name"]    = "Operating";
+    dash.update(telemetry);
+
+    char buf[256];
+    const size_t len = dash.serializeData(buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("/*78.45,Operating*/\r\n", buf);
+    TEST_ASSERT_EQUAL(strlen(buf), len);
+}
+
+void test_dashboard_ingest_filters_raw_telemetry(void) {
+    ss::Dashboard dash(kTestCfg);
+    dash.begin();
+    char buf[256];
+
+    // Unused fields are parsed past; only slot paths reach update().
+    const char json[] =
+        "{\"blob\":[1,2,3,{\"k\":9}],\"temperature\":{\"k\":81.5,\"c\":-191},"
+        "\"state\":{\"name\":\"Cooling\",\"code\":4}}";
+    TEST_ASSERT_TRUE(dash.ingest(json, strlen(json)));
+    dash.serializeData(buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("/*81.5,Cooling*/\r\n", buf);
+
+    // MessagePack takes the same path.
+    JsonDocument doc;
+    doc["temperature"]["k"] = 90;
+    doc["state"]["name"]    = "Idle";
+    doc["noise"]            = "ignored";
+    uint8_t packed[96];
+    const size_t n = serializeMsgPack(doc, packed, sizeof(packed));
+    TEST_ASSERT_TRUE(dash.ingest(packed, n, ss::Dashboard::Encoding::MsgPack));
+    dash.serializeData(buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("/*90,Idle*/\r\n", buf);
+
+    // Malformed input leaves every value alone.
+    TEST_ASSERT_FALSE(dash.ingest("{\"temperature\":{\"k\":1", 20));
+    TEST_ASSERT_FALSE(dash.ingest(nullptr, 0));
+    dash.serializeData(buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("/*90,Idle*/\r\n", buf);
+}
+
+void test_dashboard_pooled_telemetry(void) {
+    // The pool hands freed blocks back out instead of freeing them.
+    ss::TelemetryPool pool;
+    void* a = pool.allocate(100);
+    pool.deallocate(a);
+    TEST_ASSERT_TRUE(pool.allocate(40) == a);
+    TEST_ASSERT_EQUAL(100, pool.stats().inUse);
+    void* b = pool.reallocate(a, 300);
+    TEST_ASSERT_NOT_NULL(b);
+    TEST_ASSERT_EQUAL(300, pool.stats().inUse);
+    TEST_ASSERT_EQUAL(0, pool.stats().cached);
+    TEST_ASSERT_EQUAL(400, pool.stats().peak);
+    pool.deallocate(b);
+
+    // A buffer grown step by step each tick leaves only its final block
+    // cached, and later ticks reuse it without touching the heap.
+    for (int tick = 0; tick < 3; ++tick) {
+        void* p = pool.allocate(16);
+        for (size_t size = 32; size <= 512; size *= 2) p = pool.reallocate(p, size);
+        pool.deallocate(p);
+        TEST_ASSERT_EQUAL(512, pool.stats().cached);
+    }
+    TEST_ASSERT_EQUAL(3, pool.stats().heapAllocs);
+    pool.release();
+    TEST_ASSERT_EQUAL(0, pool.stats().cached);
+
+    // Steady-state ticks through the Dashboard's document stay off the heap.
+    ss::Dashboard dash(kTestCfg);
+    dash.begin();
+    const char json[] = "{\"temperature\":{\"k\":81.5},\"state\":{\"name\":\"Run\"}}";
+    TEST_ASSERT_TRUE(dash.ingest(json, strlen(json)));
+    const ss::TelemetryPool::Stats first = dash.telemetryStats();
+    TEST_ASSERT_GREATER_THAN(0, first.heapAllocs);
+    for (int i = 0; i < 5; ++i) TEST_ASSERT_TRUE(dash.ingest(json, strlen(json)));
+    TEST_ASSERT_EQUAL(first.heapAllocs, dash.telemetryStats().heapAllocs);
+    TEST_ASSERT_EQUAL(first.peak, dash.telemetryStats().peak);
+    TEST_ASSERT_GREATER_OR_EQUAL(5, dash.telemetryStats().reuses);
+
+    JsonDocument& telemetry = dash.beginTelemetry();
+    TEST_ASSERT_EQUAL(0, dash.telemetryStats().inUse);
+    TEST_ASSERT_EQUAL(dash.telemetryStats().cached, dash.footprint().telemetry);
+    telemetry["temperature"]["k"] = 12;
+    telemetry["state"]["name"]    = "Idle";
+    dash.update(telemetry);
+    char buf[64];
+    dash.serializeData(buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("/*12,Idle*/\r\n", buf);
+
+    dash.releaseTelemetry();
+    TEST_ASSERT_EQUAL(0, dash.footprint().telemetry);
+}
+
+void test_dashboard_fft_ring_drains_as_burst(void) {
+    ss::Dashboard dash(kFftCfg);
+    dash.begin();
+
+    const int slot = dash.findSlot("vib");
+    TEST_ASSERT_EQUAL(0, slot);
+    TEST_ASSERT_FALSE(dash.pushSample(dash.findSlot("temp"), 1.0f));  // no ring
+
+    TEST_ASSERT_TRUE(dash.pushSample(slot, 1.5f));
+    TEST_ASSERT_TRUE(dash.pushSample(slot, 2.5f));
+    TEST_ASSERT_TRUE(dash.pushSample(slot, 3.5f));
+    TEST_ASSERT_EQUAL(3, dash.pendingSamples(slot));
+
+    char buf[256];
+    dash.serializeData(buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("/*1.5,0*/\r\n/*2.5,0*/\r\n/*3.5,0*/\r\n", buf);
+    TEST_ASSERT_EQUAL(0, dash.pendingSamples(slot));
+
+    // With the ring empty a single row carries the last drained sample.
+    dash.serializeData(buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("/*3.5,0*/\r\n", buf);
+}
+
+void test_dashboard_fft_burst_keeps_unsent_samples(void) {
+    ss::Dashboard dash(kFftCfg);
+    dash.begin();
+
+    const int slot = dash.findSlot("vib");
+    for (int i = 0; i < 4; ++i) dash.pushSample(slot, static_cast<float>(i));
+
+    char buf[24];   // room for two 9-byte rows plus NUL
+    const size_t len = dash.serializeData(buf, sizeof(buf));
+    TEST_ASSERT_EQUAL(18, len);
+    TEST_ASSERT_EQUAL(2, dash.pendingSamples(slot));
+}
+
+void test_dashboard_batch_emits_one_row_per_timestamp(void) {
+    ss::Dashboard dash(kFftCfg);
+    dash.begin();
+    TEST_ASSERT_FALSE(dash.queueSample(0, 1.0f, 0));   // no buffer reserved
+    TEST_ASSERT_TRUE(dash.reserveBatch(8));
+
+    const int vib  = dash.findSlot("vib");
+    const int temp = dash.findSlot("temp");
+    dash.queueSample(vib,  0.5f, 1000);
+    dash.queueSample(temp, 21.0f, 1000);
+    dash.queueSample(vib,  0.75f, 2000);    // temp holds 21 on this row
+    TEST_ASSERT_EQUAL(3, dash.batchedSamples());
+
+    char buf[256];
+    const size_t len = dash.serializeBatch(buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("/*0.5,21*/\r\n/*0.75,21*/\r\n", buf);
+    TEST_ASSERT_EQUAL(strlen(buf), len);
+    TEST_ASSERT_EQUAL(0, dash.batchedSamples());
+
+    // The last batched values become the current values.
+    dash.serializeData(buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("/*0.75,21*/\r\n", buf);
+}
+
+void test_dashboard_batch_keeps_rows_that_do_not_fit(void) {
+    ss::Dashboard dash(kFftCfg);
+    dash.begin();
+    dash.reserveBatch(8);
+
+    for (uint32_t t = 0; t < 3; ++t) dash.queueSample(0, 1.0f, t);
+
+    char buf[12];   // one 9-byte row
+    TEST_ASSERT_EQUAL(9, dash.serializeBatch(buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL(2, dash.batchedSamples());
+}
+
+void test_dashboard_aggregates_between_frames(void) {
+    ss::Dashboard dash(kAggCfg);
+    dash.begin();
+
+    const float samples[][4] = {
+        {  1.0f, 10.0f,  3.0f,  2.0f },
+        {  9.0f, 20.0f, -3.0f, -7.0f },
+        {  4.0f, 30.0f,  3.0f,  1.0f },
+    };
+    for (const auto& row : samples) {
+        JsonDocument telemetry;
+        telemetry["i"] = row[0];
+        telemetry["v"] = row[1];
+        telemetry["n"] = row[2];
+        telemetry["p"] = row[3];
+        dash.update(telemetry);
+    }
+
+    char buf[128];
+    dash.serializeData(buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("/*9,20,3,-7*/\r\n", buf);
+
+    // The frame closed the windows; peak-hold carries over.
+    dash.setValue(dash.findSlot("i"), 2.0f);
+    dash.setValue(dash.findSlot("p"), 5.0f);
+    dash.serializeData(buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("/*2,20,3,-7*/\r\n", buf);
+
+    dash.clearPeaks();
+    dash.setValue(dash.findSlot("p"), 5.0f);
+    dash.serializeData(buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("/*2,20,3,5*/\r\n", buf);
+
+    // Samples only touch the window; it is formatted when a frame is
+    // measured or written, so the estimate matches what goes out.
+    for (int i = 0; i < 1000; ++i) dash.setValue(dash.findSlot("v"), static_cast<float>(i % 10));
+    char frame[2048];
+    const size_t est = dash.estimateSize();
+    TEST_ASSERT_EQUAL(est - 1, dash.serialize(frame, sizeof(frame)));
+    TEST_ASSERT_NOT_NULL(strstr(frame, "\"value\":\"4.5\""));
+
+    // Measuring is pure: the window stays open across estimateSize(), so
+    // later samples of the same frame still fold into the mean.
+    dash.setValue(dash.findSlot("v"), 10.0f);
+    const ss::Dashboard& view = dash;
+    TEST_ASSERT_EQUAL(view.estimateSize(), view.estimateSize());
+    dash.setValue(dash.findSlot("v"), 20.0f);
+    TEST_ASSERT_EQUAL(dash.estimateSize() - 1, dash.serialize(frame, sizeof(frame)));
+    TEST_ASSERT_NOT_NULL(strstr(frame, "\"value\":\"15\""));
+}
+
+struct AlarmLog {
+    int            count = 0;
+    ss::AlarmEvent last  = {};
+};
+
+static void recordAlarm(void* ctx, const ss::AlarmEvent& ev) {
+    auto* log = static_cast<AlarmLog*>(ctx);
+    ++log->count;
+    log->last = ev;
+}
+
+void test_dashboard_alarm_edges_with_hysteresis(void) {
+    ss::Dashboard dash(kAlarmCfg);
+    dash.begin();
+    AlarmLog log;
+    dash.onAlarm(&recordAlarm, &log);
+    const int slot = dash.findSlot("bar");
+
+    dash.setValue(slot, 50.0f);
+    TEST_ASSERT_EQUAL(0, log.count);
+    TEST_ASSERT_FALSE(dash.priorityFramePending());
+
+    dash.setValue(slot, 95.0f);
+    TEST_ASSERT_EQUAL(1, log.count);
+    TEST_ASSERT_TRUE(log.last.state == ss::AlarmState::High);
+    TEST_ASSERT_TRUE(dash.priorityFramePending());
+
+    char buf[64];
+    dash.serializeData(buf, sizeof(buf));
+    TEST_ASSERT_FALSE(dash.priorityFramePending());
+
+    dash.setValue(slot, 88.0f);                       // inside the 5-unit band
+    TEST_ASSERT_EQUAL(1, log.count);
+    TEST_ASSERT_TRUE(dash.alarmState(slot) == ss::AlarmState::High);
+
+    dash.setValue(slot, 84.0f);
+    TEST_ASSERT_EQUAL(2, log.count);
+    TEST_ASSERT_TRUE(log.last.state == ss::AlarmState::Normal);
+    TEST_ASSERT_TRUE(log.last.previous == ss::AlarmState::High);
+
+    // JSON telemetry goes through the same evaluation.
+    JsonDocument telemetry;
+    telemetry["bar"] = 5;
+    dash.update(telemetry);
+    TEST_ASSERT_EQUAL(3, log.count);
+    TEST_ASSERT_TRUE(log.last.state == ss::AlarmState::Low);
+    TEST_ASSERT_EQUAL_FLOAT(5.0f, log.last.value);
+}
+
+static const ss::DatasetCfg kVibAlarmDatasets[] = {
+    { .title = "Vibration", .telemetryKey = "vib",
+      .alarmLow = -100, .alarmHigh = 10, .alarmEnabled = true,
+      .fft = true, .fftSamples = 16, .fftSamplingRate = 1000,
+      .alarmImmediate = true },
+};
+
+static const ss::GroupCfg kVibAlarmGroups[] = {
+    { .title = "Shaft", .datasets = kVibAlarmDatasets, .datasetCount = 1 },
+};
+
+static const ss::DashboardCfg kVibAlarmCfg = {
+    .title      = "Ring alarms",
+    .groups     = kVibAlarmGroups,
+    .groupCount = 1,
+};
+
+void test_dashboard_alarms_see_ring_and_batch_samples(void) {
+    ss::Dashboard dash(kVibAlarmCfg);
+    dash.begin();
+    dash.reserveBatch(4);
+    AlarmLog log;
+    dash.onAlarm(&recordAlarm, &log);
+    const int vib = dash.findSlot("vib");
+
+    // Ring samples are checked as they drain, one by one: the spike
+    // between two quiet samples is caught.
+    dash.pushSample(vib, 1.0f);
+    dash.pushSample(vib, 12.0f);
+    dash.pushSample(vib, 2.0f);
+    TEST_ASSERT_EQUAL(0, log.count);
+    char buf[256];
+    TEST_ASSERT_GREATER_THAN(0, dash.serializeData(buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL(2, log.count);
+    TEST_ASSERT_TRUE(log.last.state == ss::AlarmState::Normal);
+    TEST_ASSERT_TRUE(log.last.previous == ss::AlarmState::High);
+
+    // Batched samples are checked on arrival and request a priority frame.
+    dash.queueSample(vib, 15.0f, 100);
+    TEST_ASSERT_EQUAL(3, log.count);
+    TEST_ASSERT_TRUE(log.last.state == ss::AlarmState::High);
+    TEST_ASSERT_EQUAL_FLOAT(15.0f, log.last.value);
+    TEST_ASSERT_TRUE(dash.priorityFramePending());
+    TEST_ASSERT_GREATER_THAN(0, dash.serializeBatch(buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL(3, log.count);
+    TEST_ASSERT_FALSE(dash.priorityFramePending());
+}
+
+void test_dashboard_scheduler_rates_and_round_robin(void) {
+    ss::Dashboard dash(kSchedCfg);
+    dash.begin();
+    TEST_ASSERT_TRUE(dash.isDue(4));                   // everything due by default
+
+    // Frame 0 @ 0 ms: loop, 10 Hz (first run), first housekeeping slot.
+    TEST_ASSERT_EQUAL(3, dash.beginFrame(0));
+    TEST_ASSERT_TRUE(dash.isDue(0));
+    TEST_ASSERT_FALSE(dash.isDue(1));
+    TEST_ASSERT_TRUE(dash.isDue(2));
+    TEST_ASSERT_TRUE(dash.isDue(3));
+    TEST_ASSERT_FALSE(dash.isDue(4));
+
+    // Frame 1 @ 50 ms: half-rate slot's turn, 10 Hz rate-limited, next housekeeping.
+    TEST_ASSERT_EQUAL(3, dash.beginFrame(50));
+    TEST_ASSERT_TRUE(dash.isDue(1));
+    TEST_ASSERT_FALSE(dash.isDue(2));
+    TEST_ASSERT_FALSE(dash.isDue(3));
+    TEST_ASSERT_TRUE(dash.isDue(4));
+
+    // Frame 2 @ 100 ms: 10 Hz due again, housekeeping wraps round.
+    dash.beginFrame(100);
+    TEST_ASSERT_TRUE(dash.isDue(2));
+    TEST_ASSERT_TRUE(dash.isDue(3));
+
+    // A slot that is not due takes its sample, but its text waits...
+    JsonDocument telemetry;
+    telemetry["c"]  = 1;
+    telemetry["n2"] = 2;
+    dash.update(telemetry);
+
+    char buf[64];
+    dash.serializeData(buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("/*1,0,0,0,0*/\r\n", buf);
+
+    // ...until its next turn, with no new telemetry needed.
+    dash.beginFrame(150);
+    TEST_ASSERT_TRUE(dash.isDue(1));
+    dash.serializeData(buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("/*1,2,0,0,0*/\r\n", buf);
+}
+
+static const ss::DatasetCfg kSlowDatasets[] = {
+    { .title = "Peak", .telemetryKey = "pk",
+      .alarmLow = -1000, .alarmHigh = 50, .alarmEnabled = true,
+      .aggregate = ss::Aggregate::Max, .updateEvery = 4 },
+};
+
+static const ss::GroupCfg kSlowGroups[] = {
+    { .title = "Slow", .datasets = kSlowDatasets, .datasetCount = 1 },
+};
+
+static const ss::DashboardCfg kSlowCfg = {
+    .title      = "Slow channel",
+    .groups     = kSlowGroups,
+    .groupCount = 1,
+};
+
+void test_dashboard_scheduler_keeps_windows_and_alarms(void) {
+    ss::Dashboard dash(kSlowCfg);
+    dash.begin();
+    AlarmLog log;
+    dash.onAlarm(&recordAlarm, &log);
+    char buf[64];
+
+    dash.beginFrame(0);
+    dash.setValue(0, 1.0f);
+    TEST_ASSERT_GREATER_THAN(0, dash.serializeData(buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_STRING("/*1*/\r\n", buf);
+
+    // Between refreshes the window keeps folding and no row is sent.
+    const float between[] = {30.0f, 5.0f, 3.0f};
+    for (uint32_t f = 1; f <= 3; ++f) {
+        dash.beginFrame(f * 10);
+        dash.setValue(0, between[f - 1]);
+        TEST_ASSERT_EQUAL(0, dash.serializeData(buf, sizeof(buf)));
+    }
+
+    // The next refresh shows the transient the skipped frames saw.
+    dash.beginFrame(40);
+    TEST_ASSERT_GREATER_THAN(0, dash.serializeData(buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_STRING("/*30*/\r\n", buf);
+
+    // A spike on a frame the slot is not due still trips the alarm, and
+    // makes the slot due so the frame reporting it carries the value.
+    dash.beginFrame(50);
+    TEST_ASSERT_FALSE(dash.isDue(0));
+    dash.setValue(0, 80.0f);
+    TEST_ASSERT_EQUAL(1, log.count);
+    TEST_ASSERT_TRUE(log.last.state == ss::AlarmState::High);
+    TEST_ASSERT_TRUE(dash.isDue(0));
+    TEST_ASSERT_GREATER_THAN(0, dash.serializeData(buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_STRING("/*80*/\r\n", buf);
+}
+
+void test_dashboard_packed_decoder_rows(void) {
+    JsonDocument telemetry;
+    telemetry["temperature"]["k"] = 1.0f;
+    telemetry["state"]["name"]    = "Operating";   // no numeric form → NaN
+
+    char buf[256];
+
+    ss::Dashboard hex(kHexCfg);
+    hex.begin();
+    hex.update(telemetry);
+    hex.serializeData(buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("/*0000803F0000C07F*/\r\n", buf);
+
+    ss::Dashboard b64(kBase64Cfg);
+    b64.begin();
+    b64.update(telemetry);
+    b64.serializeData(buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("/*AACAPwAAwH8=*/\r\n", buf);
+
+    // The project selects the decoder and installs the float32 parser.
+    char big[8192];
+    const size_t len = b64.serialize(big, sizeof(big));
+    JsonDocument doc;
+    TEST_ASSERT_TRUE(deserializeJson(doc, big + 2, len - 6) == DeserializationError::Ok);
+    TEST_ASSERT_EQUAL(2, doc["decoder"].as<int>());
+    TEST_ASSERT_NOT_NULL(strstr(doc["frameParser"].as<const char*>(), "getFloat32"));
+}
+
+void test_static_project_matches_runtime(void) {
+    char buf[8192];
+
+    // Same bytes as serialize() straight after begin() — checksum included.
+    using Plain = ss::StaticProject<kTestCfg>;
+    ss::Dashboard plain(kTestCfg);
+    plain.begin();
+    TEST_ASSERT_EQUAL(Plain::kFrameSize, plain.serialize(buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_STRING(buf, Plain::frame());
+
+    using Checked = ss::StaticProject<kCrcCfg>;
+    ss::Dashboard checked(kCrcCfg);
+    checked.begin();
+    TEST_ASSERT_EQUAL(Checked::kFrameSize, checked.serialize(buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL(0, memcmp(buf, Checked::frame(), Checked::kFrameSize));
+
+    using Packed = ss::StaticProject<kBase64Cfg>;
+    ss::Dashboard packed(kBase64Cfg);
+    packed.begin();
+    TEST_ASSERT_EQUAL(Packed::kFrameSize, packed.serialize(buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_STRING(buf, Packed::frame());
+
+    static_assert(Plain::kFrameSize == Plain::kJsonSize + 6, "frame = JSON + delimiters + CRLF");
+}
+
+void test_project_writer_formats_numbers(void) {
+    auto fmt = [](double v, char (&out)[32]) {
+        ss::FixedString<31> f;
+        ss::ProjectWriter<ss::FixedString<31>> w(f);
+        w.number(v);
+        memcpy(out, f.data, f.size + 1);
+        return static_cast<const char*>(out);
+    };
+    char out[32];
+    TEST_ASSERT_EQUAL_STRING("300",          fmt(300, out));
+    TEST_ASSERT_EQUAL_STRING("-0.5",         fmt(-0.5, out));
+    TEST_ASSERT_EQUAL_STRING("0.1",          fmt(0.1f, out));
+    TEST_ASSERT_EQUAL_STRING("123457",       fmt(123456.7, out));
+    TEST_ASSERT_EQUAL_STRING("1.23457e+06",  fmt(1234567, out));
+    TEST_ASSERT_EQUAL_STRING("0.000125",     fmt(0.000125, out));
+    TEST_ASSERT_EQUAL_STRING("1e-05",        fmt(0.00001, out));
+}
+
+void test_dashboard_frame_size_bounds(void) {
+    ss::Dashboard dash(kTestCfg);
+    dash.begin();
+    TEST_ASSERT_EQUAL((ss::StaticProject<kTestCfg>::kMaxFrameSize), dash.maxFrameSize());
+    TEST_ASSERT_EQUAL((ss::StaticProject<kTestCfg>::kMaxRowSize),   dash.maxRowSize());
+
+    // An estimateSize() buffer fits exactly; one byte less must fail
+    // instead of emitting truncated JSON.
+    char buf[8192];
+    const size_t est = dash.estimateSize();
+    TEST_ASSERT_EQUAL(est - 1, dash.serialize(buf, est));
+    TEST_ASSERT_EQUAL(0, dash.serialize(buf, est - 1));
+
+    const size_t pest = dash.estimatePrettySize();
+    TEST_ASSERT_EQUAL(pest - 1, dash.serialize(buf, pest, /*pretty=*/true));
+    TEST_ASSERT_EQUAL(0, dash.serialize(buf, pest - 1, /*pretty=*/true));
+
+    // Widest number plus an over-long string: the bound is met exactly.
+    JsonDocument telemetry;
+    telemetry["temperature"]["k"] = -1.17549435e-38f;
+    telemetry["state"]["name"]    = "Overtemperature shutdown";
+    dash.update(telemetry);
+
+    TEST_ASSERT_EQUAL(dash.maxFrameSize() - 1, dash.serialize(buf, dash.maxFrameSize()));
+    TEST_ASSERT_NOT_NULL(strstr(buf, "\"Overtemperat\""));   // clipped to 12 bytes
+    TEST_ASSERT_EQUAL(dash.maxFrameSize(true) - 1,
+                      dash.serialize(buf, dash.maxFrameSize(true), /*pretty=*/true));
+    TEST_ASSERT_EQUAL(dash.maxRowSize() - 1, dash.serializeData(buf, dash.maxRowSize()));
+}
+
+void test_dashboard_typed_setters_and_footprint(void) {
+    ss::Dashboard dash(kTestCfg);
+    dash.begin();
+    const int temp  = dash.findSlot("temperature.k");
+    const int state = dash.findSlot("state.name");
+
+    // The typed setters alone drive the frame — no JsonDocument involved.
+    char buf[2048];
+    dash.setValue(temp, 78.5f);
+    dash.setText(state, "Say \"hi\"");
+    TEST_ASSERT_GREATER_THAN(0, dash.serialize(buf, sizeof(buf)));
+    TEST_ASSERT_NOT_NULL(strstr(buf, "\"value\":\"78.5\""));
+    TEST_ASSERT_NOT_NULL(strstr(buf, "\"value\":\"Say \\\"hi\\\"\""));
+    TEST_ASSERT_EQUAL(dash.estimateSize() - 1, strlen(buf));
+
+    // Template and value text are the only per-frame heap state.
+    const ss::Dashboard::Footprint fp = dash.footprint();
+    TEST_ASSERT_EQUAL(ss::StaticProject<kTestCfg>::kJsonSize - 2, fp.templates);
+    TEST_ASSERT_EQUAL(2 * (ss::kNumericValueWidth + 1), fp.values);
+    TEST_ASSERT_EQUAL(0, fp.rings);
+    TEST_ASSERT_EQUAL(fp.object + fp.templates + fp.values, fp.total());
+}
+
+#pragma pack(push, 1)
+struct SensorFrame {
+    uint8_t  seq;
+    float    tempK;           // unaligned at offset 1
+    int16_t  rssi;
+    bool     armed;
+    uint32_t uptime;
+};
+
+struct PowerFrame {
+    uint16_t mV;
+    double   amps;
+};
+#pragma pack(pop)
+
+enum class Mode : uint8_t { Idle, Run };
+
+static constexpr ss::DatasetCfg kStructDatasets[] = {
+    { .title = "Temp",  .telemetryKey = "air.t", .alarmLow = 0, .alarmHigh = 300,
+      .alarmEnabled = true, .field = SS_FIELD(0, SensorFrame, tempK) },
+    { .title = "RSSI",  .telemetryKey = "radio.rssi",
+      .field = SS_FIELD(0, SensorFrame, rssi) },
+    { .title = "Armed", .telemetryKey = "armed",
+      .field = SS_FIELD(0, SensorFrame, armed) },
+    { .title = "Volts", .telemetryKey = "power.mv",
+      .field = SS_FIELD(1, PowerFrame, mV) },
+    { .title = "Amps",  .telemetryKey = "power.a", .aggregate = ss::Aggregate::Max,
+      .field = SS_FIELD(1, PowerFrame, amps) },
+    { .title = "Note",  .telemetryKey = "note" },
+};
+
+static constexpr ss::GroupCfg kStructGroups[] = {
+    { .title = "Node", .datasets = kStructDatasets, .datasetCount = 6 },
+};
+
+static constexpr ss::DashboardCfg kStructCfg = {
+    .title = "Structs", .groups = kStructGroups, .groupCount = 1,
+};
+
+void test_dashboard_struct_fields(void) {
+    static_assert(ss::fieldTypeOf<const float>() == ss::FieldType::F32, "");
+    static_assert(ss::fieldTypeOf<Mode>() == ss::FieldType::U8, "");
+    static_assert(ss::fieldTypeOf<long long>() == ss::FieldType::None, "");
+    static_assert(kStructDatasets[1].field.offset == 5, "");
+    static_assert(kStructDatasets[1].field.type == ss::FieldType::I16, "");
+
+    ss::Dashboard dash(kStructCfg);
+    dash.begin();
+    AlarmLog log;
+    dash.onAlarm(recordAlarm, &log);
+
+    // Each struct only touches the datasets bound to its source id.
+    const SensorFrame sensor = {7, 321.5f, -67, true, 12345};
+    PowerFrame power = {3300, 0.25};
+    dash.setText(dash.findSlot("note"), "ok");
+    dash.update(&sensor, 0);
+    dash.update(&power, 1);
+    power.amps = 0.75;
+    dash.update(&power, 1);
+    power.amps = 0.5;
+    dash.update(&power, 1);
+
+    char buf[256];
+    dash.serializeData(buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("/*321.5,-67,1,3300,0.75,ok*/\r\n", buf);
+
+    // Struct samples go through alarms like setValue().
+    TEST_ASSERT_EQUAL(1, log.count);
+    TEST_ASSERT_TRUE(log.last.state == ss::AlarmState::High);
+    TEST_ASSERT_EQUAL_FLOAT(321.5f, log.last.value);
+
+    // Unknown sources and null pointers are ignored.
+    dash.update(&sensor, 9);
+    dash.update(nullptr, 0);
+    dash.serializeData(buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("/*321.5,-67,1,3300,0.75,ok*/\r\n", buf);
+}
+
+// Bound only to a struct member: the slot exists without a telemetry key.
+static constexpr ss::DatasetCfg kFieldOnlyDatasets[] = {
+    { .title = "Temp", .alarmLow = 0, .alarmHigh = 300, .alarmEnabled = true,
+      .field = SS_FIELD(0, SensorFrame, tempK) },
+    { .title = "RSSI", .telemetryKey = "radio.rssi",
+      .field = SS_FIELD(0, SensorFrame, rssi) },
+    { .title = "Label" },
+};
+
+static constexpr ss::GroupCfg kFieldOnlyGroups[] = {
+    { .title = "Node", .datasets = kFieldOnlyDatasets, .datasetCount = 3 },
+};
+
+static constexpr ss::DashboardCfg kFieldOnlyCfg = {
+    .title = "Structs", .groups = kFieldOnlyGroups, .groupCount = 1,
+};
+
+void test_dashboard_struct_field_only(void) {
+    using Project = ss::StaticProject<kFieldOnlyCfg>;
+    static_assert(ss::maxValueWidth(kFieldOnlyDatasets[0]) == ss::kNumericValueWidth, "");
+    static_assert(ss::maxValueWidth(kFieldOnlyDatasets[2]) == 1, "");
+
+    ss::Dashboard dash(kFieldOnlyCfg);
+    dash.begin();
+    TEST_ASSERT_EQUAL(Project::kMaxFrameSize, dash.maxFrameSize());
+    AlarmLog log;
+    dash.onAlarm(recordAlarm, &log);
+
+    const SensorFrame sensor = {7, 321.5f, -67, true, 12345};
+    dash.update(&sensor, 0);
+
+    char buf[256];
+    dash.serializeData(buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("/*321.5,-67,0*/\r\n", buf);
+
+    // The keyless slot raises alarms like any other; the JSON path skips it.
+    TEST_ASSERT_EQUAL(1, log.count);
+    TEST_ASSERT_EQUAL(0, log.last.slot);
+    TEST_ASSERT_NULL(log.last.telemetryKey);
+    TEST_ASSERT_EQUAL(1, dash.findSlot("radio.rssi"));
+
+    JsonDocument telemetry;
+    telemetry["radio"]["rssi"] = -70;
+    dash.update(telemetry);
+    dash.serializeData(buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("/*321.5,-70,0*/\r\n", buf);
+}
+
+static constexpr ss::DatasetCfg kKindDatasets[] = {
+    { .title = "Uptime", .telemetryKey = "uptime" },
+    { .title = "Heap",   .telemetryKey = "heap", .kind = ss::ValueKind::UInt },
+    { .title = "Armed",  .telemetryKey = "armed" },
+    { .title = "Mode",   .telemetryKey = "mode" },
+    { .title = "Mean",   .telemetryKey = "mean", .aggregate = ss::Aggregate::Mean },
+};
+
+static constexpr ss::GroupCfg kKindGroups[] = {
+    { .title = "Kinds", .datasets = kKindDatasets, .datasetCount = 5 },
+};
+
+static constexpr ss::DashboardCfg kKindCfg = {
+    .title = "Kinds", .groups = kKindGroups, .groupCount = 1,
+};
+
+void test_dashboard_value_kinds(void) {
+    ss::Dashboard dash(kKindCfg);
+    dash.begin();
+    char buf[128];
+
+    // Kinds are inferred from the first values; integers print exactly,
+    // unless an aggregate needs float math.
+    JsonDocument telemetry;
+    telemetry["uptime"] = 1234567;
+    telemetry["heap"]   = 4000000000u;
+    telemetry["armed"]  = true;
+    telemetry["mode"]   = "Run";
+    telemetry["mean"]   = 3;
+    dash.update(telemetry);
+    telemetry["mean"]   = 4;
+    dash.update(telemetry);
+    dash.serializeData(buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("/*1234567,4000000000,1,Run,3.5*/\r\n", buf);
+
+    // An inferred kind follows the telemetry; a declared one stays put and
+    // takes odd values one at a time.
+    telemetry["uptime"] = 12.5f;
+    telemetry["heap"]   = "n/a";
+    dash.update(telemetry);
+    dash.serializeData(buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("/*12.5,n/a,1,Run,4*/\r\n", buf);
+    telemetry["uptime"] = 13;
+    telemetry["heap"]   = 7;
+    dash.update(telemetry);
+    dash.serializeData(buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("/*13,7,1,Run,4*/\r\n", buf);
+
+    // Typed setters pick their handler at compile time.
+    dash.set(0, static_cast<int64_t>(-9876543210));
+    dash.set(1, static_cast<uint16_t>(65535));
+    dash.set(2, false);
+    dash.set(3, "Idle");
+    dash.set(4, 2.25);
+    dash.serializeData(buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("/*-9876543210,65535,0,Idle,2.25*/\r\n", buf);
+
+    // Too wide for the slot: falls back to "%.6g" rather than being cut.
+    dash.set(0, static_cast<int64_t>(-1234567890123LL));
+    dash.serializeData(buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("/*-1.23457e+12,65535,0,Idle,2.25*/\r\n", buf);
+}
+
+enum class ChargeMode : uint8_t { Idle, Charging, Fault };
+
+static constexpr const char* kChargeModeNames[] = {
+    "Idle", "Charging", "Overtemperature \"shutdown\"",
+};
+
+static constexpr ss::DatasetCfg kEnumDatasets[] = {
+    { .title = "Mode", .telemetryKey = "mode",
+      .labels = kChargeModeNames, .labelCount = 3 },
+    { .title = "Volts", .telemetryKey = "volts" },
+};
+
+static constexpr ss::GroupCfg kEnumGroups[] = {
+    { .title = "Charger", .datasets = kEnumDatasets, .datasetCount = 2 },
+};
+
+static constexpr ss::DashboardCfg kEnumCfg = {
+    .title = "Charger", .groups = kEnumGroups, .groupCount = 1,
+};
+
+// A count without a table: the count must be ignored, not dereferenced.
+static constexpr ss::DatasetCfg kNoTableDatasets[] = {
+    { .title = "Mode", .telemetryKey = "mode", .labelCount = 3 },
+};
+
+static constexpr ss::GroupCfg kNoTableGroups[] = {
+    { .title = "Charger", .datasets = kNoTableDatasets, .datasetCount = 1 },
+};
+
+static constexpr ss::DashboardCfg kNoTableCfg = {
+    .title = "Charger", .groups = kNoTableGroups, .groupCount = 1,
+};
+
+void test_dashboard_enum_labels(void) {
+    using Project = ss::StaticProject<kEnumCfg>;
+    static_assert(ss::maxValueWidth(kEnumDatasets[0]) == 28,
+                  "the longest escaped label sets the slot width");
+
+    ss::Dashboard dash(kEnumCfg);
+    dash.begin();
+    TEST_ASSERT_EQUAL(Project::kMaxFrameSize, dash.maxFrameSize());
+    const int mode = dash.findSlot("mode");
+    char buf[1024];
+
+    // Integers from the telemetry are shown as their label.
+    JsonDocument telemetry;
+    telemetry["mode"]  = 1;
+    telemetry["volts"] = 12;
+    dash.update(telemetry);
+    dash.serializeData(buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("/*Charging,12*/\r\n", buf);
+
+    // The label is escaped straight from the table, and the longest one
+    // meets the frame size bound exactly next to the widest number.
+    dash.set(mode, ChargeMode::Fault);
+    dash.setValue(dash.findSlot("volts"), -1.17549435e-38f);
+    TEST_ASSERT_EQUAL(dash.maxFrameSize() - 1, dash.serialize(buf, dash.maxFrameSize()));
+    TEST_ASSERT_NOT_NULL(strstr(buf, "\"value\":\"Overtemperature \\\"shutdown\\\"\""));
+    TEST_ASSERT_EQUAL(dash.estimateSize() - 1, strlen(buf));
+
+    // A string naming a state selects it; out-of-range states are numbers.
+    telemetry["mode"] = "Idle";
+    dash.update(telemetry);
+    dash.serializeData(buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("/*Idle,12*/\r\n", buf);
+    telemetry["mode"] = 7;
+    dash.update(telemetry);
+    dash.serializeData(buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("/*7,12*/\r\n", buf);
+    telemetry["mode"] = "Booting";
+    dash.update(telemetry);
+    dash.serializeData(buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("/*Booting,12*/\r\n", buf);
+
+    // Label slots hold no copy of the text.
+    dash.set(mode, ChargeMode::Charging);
+    TEST_ASSERT_GREATER_THAN(0, dash.serialize(buf, sizeof(buf)));
+    TEST_ASSERT_NOT_NULL(strstr(buf, "\"value\":\"Charging\""));
+    TEST_ASSERT_EQUAL(dash.estimateSize() - 1, strlen(buf));
+
+    // labelCount without labels shows plain numbers and plain text.
+    ss::Dashboard bare(kNoTableCfg);
+    bare.begin();
+    bare.set(0, ChargeMode::Charging);
+    bare.serializeData(buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("/*1*/\r\n", buf);
+    telemetry.clear();
+    telemetry["mode"] = "Idle";
+    bare.update(telemetry);
+    bare.serializeData(buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("/*Idle*/\r\n", buf);
+}
+
+void test_project_omits_defaults(void) {
+    using Full = ss::StaticProject<kTestCfg>;
+    using Lean = ss::StaticProject<kLeanCfg>;
+
+    ss::Dashboard dash(kLeanCfg);
+    dash.begin();
+    char buf[2048];
+    TEST_ASSERT_EQUAL(Lean::kFrameSize, dash.serialize(buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_STRING(Lean::frame(), buf);
+
+    // Defaults are gone; configured values, titles and values stay.
+    TEST_ASSERT_NULL(strstr(buf, "fftMax"));
+    TEST_ASSERT_NULL(strstr(buf, "timerMode"));
+    TEST_ASSERT_NULL(strstr(buf, "xAxis"));
+    TEST_ASSERT_NULL(strstr(buf, "hexadecimalDelimiters"));
+    TEST_ASSERT_NOT_NULL(strstr(buf, "{\"index\":2,\"title\":\"State\",\"value\":\"0\"}"));
+    TEST_ASSERT_NOT_NULL(strstr(buf, "\"alarmHigh\":300"));
+    TEST_ASSERT_NOT_NULL(strstr(buf, "\"value\":\"0\""));
+    TEST_ASSERT_NOT_NULL(strstr(buf, "{\"eol\":\"\\n\",\"icon\":\"Play\""));
+
+    // The cost report accounts for every byte, and its savable column
+    // predicts the omitDefaults frame exactly.
+    ss::FieldCost costs[48];
+    const size_t n = ss::projectFieldCosts(kTestCfg, costs, 48);
+    size_t bytes = 0, savable = 0;
+    const ss::FieldCost* fftMax  = nullptr;
+    const ss::FieldCost* ledHigh = nullptr;
+    for (size_t i = 0; i < n; ++i) {
+        bytes   += costs[i].bytes;
+        savable += costs[i].savable;
+        if (costs[i].key && strcmp(costs[i].key, "fftMax") == 0)  fftMax  = &costs[i];
+        if (costs[i].key && strcmp(costs[i].key, "ledHigh") == 0) ledHigh = &costs[i];
+    }
+    TEST_ASSERT_EQUAL(Full::kJsonSize, bytes);
+    TEST_ASSERT_EQUAL(Full::kJsonSize - Lean::kJsonSize, savable);
+    TEST_ASSERT_NOT_NULL(fftMax);
+    TEST_ASSERT_EQUAL(2, fftMax->count);
+    TEST_ASSERT_EQUAL(2, fftMax->defaults);
+    TEST_ASSERT_EQUAL(2 * strlen(",\"fftMax\":0"), fftMax->bytes);
+    TEST_ASSERT_NOT_NULL(ledHigh);
+    TEST_ASSERT_EQUAL(2, ledHigh->defaults);
+    TEST_ASSERT_EQUAL(2 * strlen(",\"ledHigh\":0"), ledHigh->savable);
+}
+
+void test_dashboard_cached_pretty_template(void) {
+    static char live[8192];
+    static char cached[8192];
+
+    ss::Dashboard dash(kCrcCfg);
+    dash.begin();
+    JsonDocument telemetry;
+    telemetry["temperature"]["k"] = 78.4f;
+    telemetry["state"]["name"]    = "Run \"A\"";
+    dash.update(telemetry);
+    const size_t liveLen  = dash.serialize(live, sizeof(live), /*pretty=*/true);
+    const size_t compact0 = dash.footprint().templates;
+
+    // The cached template patches values into the same bytes.
+    TEST_ASSERT_TRUE(dash.cachePretty());
+    TEST_ASSERT_EQUAL(liveLen, dash.serialize(cached, sizeof(cached), /*pretty=*/true));
+    TEST_ASSERT_EQUAL(0, memcmp(live, cached, liveLen));
+    TEST_ASSERT_GREATER_THAN(compact0, dash.footprint().templates);
+
+    // Wider indent: sizes follow, and the compact frame is unaffected.
+    TEST_ASSERT_TRUE(dash.cachePretty(4));
+    const size_t len = dash.serialize(cached, sizeof(cached), /*pretty=*/true);
+    TEST_ASSERT_EQUAL(dash.estimatePrettySize() - 1, len);
+    TEST_ASSERT_NOT_NULL(strstr(cached, "{\r\n    \"title\": \"Checked\""));
+    TEST_ASSERT_GREATER_THAN(liveLen, len);
+    TEST_ASSERT_LESS_OR_EQUAL(dash.maxFrameSize(true) - 1, len);
+
+    // Set before begin(): the template is rendered there.
+    ss::Dashboard early(kCrcCfg);
+    TEST_ASSERT_TRUE(early.cachePretty(4));
+    early.begin();
+    early.update(telemetry);
+    TEST_ASSERT_EQUAL(len, early.serialize(live, sizeof(live), /*pretty=*/true));
+    TEST_ASSERT_EQUAL(0, memcmp(live, cached, len));
+
+    // 0 drops the cache and goes back to the live renderer.
+    TEST_ASSERT_TRUE(dash.cachePretty(0));
+    TEST_ASSERT_EQUAL(compact0, dash.footprint().templates);
+    TEST_ASSERT_EQUAL(liveLen, dash.serialize(cached, sizeof(cached), /*pretty=*/true));
+}
+
+void test_dashboard_runtime_layout(void) {
+    static char buf[4096];
+    static char live[4096];
+
+    ss::Dashboard dash(kTestCfg);
+    dash.begin();
+    dash.cachePretty();
+    const uint32_t v0 = dash.layoutVersion();
+
+    // Hot-plug: same bytes as a config that had the module from the start.
+    TEST_ASSERT_EQUAL(1, dash.addGroup(kModuleGroup));
+    TEST_ASSERT_EQUAL(2, dash.findSlot("module.rh"));
+    TEST_ASSERT_GREATER_THAN(v0, dash.layoutVersion());
+    TEST_ASSERT_EQUAL((ss::StaticProject<kPluggedCfg>::kFrameSize), dash.serialize(buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_STRING(ss::StaticProject<kPluggedCfg>::frame(), buf);
+    TEST_ASSERT_EQUAL((ss::StaticProject<kPluggedCfg>::kMaxFrameSize), dash.maxFrameSize());
+
+    // Hiding a dataset drops it from the project but keeps every id, slot
+    // and data-row field where it was.
+    dash.setValue(0, 5.0f);
+    TEST_ASSERT_TRUE(dash.setDatasetEnabled(0, false));
+    dash.serialize(buf, sizeof(buf));
+    TEST_ASSERT_NULL(strstr(buf, "Temp K"));
+    TEST_ASSERT_NOT_NULL(strstr(buf, "\"index\":2,"));
+    TEST_ASSERT_NOT_NULL(strstr(buf, "\"index\":3,"));
+    TEST_ASSERT_EQUAL(dash.estimateSize() - 1, strlen(buf));
+    dash.serializeData(buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("/*5,0,0*/\r\n", buf);
+
+    // Removing leaves a gap; the next dataset takes the lowest free id.
+    TEST_ASSERT_TRUE(dash.removeDataset(1));
+    TEST_ASSERT_EQUAL(-1, dash.findSlot("state.name"));
+    TEST_ASSERT_EQUAL(2, dash.findSlot("module.rh"));
+    TEST_ASSERT_EQUAL(1, dash.addDataset(1, kTestDatasets[1]));
+    TEST_ASSERT_EQUAL(1, dash.findSlot("state.name"));
+    dash.setText(1, "Idle");
+    dash.serialize(buf, sizeof(buf));
+    TEST_ASSERT_NOT_NULL(strstr(buf, "\"index\":2,\"led\":false,\"ledHigh\":0,\"log\":false,"
+                                     "\"overviewDisplay\":false,\"plotMax\":0,\"plotMin\":0,"
+                                     "\"title\":\"State\",\"units\":\"\",\"value\":\"Idle\""));
+    TEST_ASSERT_TRUE(strstr(buf, "\"State\"") < strstr(buf, "Humidity"));
+
+    // Cached pretty segments track every change, down to no groups at all.
+    for (int pass = 0; pass < 2; ++pass) {
+        const size_t len = dash.serialize(buf, sizeof(buf), /*pretty=*/true);
+        TEST_ASSERT_EQUAL(dash.estimatePrettySize() - 1, len);
+        TEST_ASSERT_LESS_OR_EQUAL(dash.maxFrameSize(true) - 1, len);
+        dash.cachePretty(0);
+        TEST_ASSERT_EQUAL(len, dash.serialize(live, sizeof(live), /*pretty=*/true));
+        TEST_ASSERT_EQUAL(0, memcmp(buf, live, len));
+        dash.cachePretty();
+        if (pass > 0) break;
+
+        TEST_ASSERT_TRUE(dash.setGroupEnabled(0, false));
+        TEST_ASSERT_TRUE(dash.removeGroup(1));
+    }
+    TEST_ASSERT_NOT_NULL(strstr(buf, "\"groups\": []"));
+    TEST_ASSERT_FALSE(dash.removeGroup(1));
+    TEST_ASSERT_EQUAL(-1, dash.addDataset(1, kModuleDatasets[0]));
+}
+
+void test_dashboard_template_cache(void) {
+    static uint8_t cache[8192];
+    static char    cold[4096];
+    static char    warm[4096];
+
+    ss::Dashboard first(kTestCfg);
+    first.cachePretty();
+    TEST_ASSERT_TRUE(first.begin());
+    TEST_ASSERT_FALSE(first.templatesRestored());
+    const size_t n = first.saveTemplates(cache, sizeof(cache));
+    TEST_ASSERT_GREATER_THAN(0, n);
+    TEST_ASSERT_EQUAL(first.templateCacheSize(), n);
+    TEST_ASSERT_EQUAL(0, first.saveTemplates(cache, n - 1));
+
+    // A warm boot with the same config copies the templates.
+    ss::Dashboard second(kTestCfg);
+    second.cachePretty();
+    TEST_ASSERT_TRUE(second.begin(cache, n));
+    TEST_ASSERT_TRUE(second.templatesRestored());
+    TEST_ASSERT_EQUAL_HEX32(first.configHash(), second.configHash());
+    TEST_ASSERT_EQUAL_HEX32(first.layoutHash(), second.layoutHash());
+    TEST_ASSERT_EQUAL(first.maxFrameSize(true), second.maxFrameSize(true));
+    for (ss::Dashboard* d : {&first, &second}) {
+        d->setValue(0, 273.5f);
+        d->setText(1, "Run");
+    }
+    for (bool pretty : {false, true}) {
+        const size_t len = first.serialize(cold, sizeof(cold), pretty);
+        TEST_ASSERT_EQUAL(len, second.serialize(warm, sizeof(warm), pretty));
+        TEST_ASSERT_EQUAL_STRING(cold, warm);
+    }
+
+    // Without a pretty cache, or with another indent, only what still fits
+    // is reused; the rest is rendered as usual.
+    ss::Dashboard live(kTestCfg);
+    TEST_ASSERT_TRUE(live.begin(cache, n));
+    TEST_ASSERT_TRUE(live.templatesRestored());
+    live.setValue(0, 273.5f);
+    live.setText(1, "Run");
+    first.serialize(cold, sizeof(cold), true);
+    live.serialize(warm, sizeof(warm), true);
+    TEST_ASSERT_EQUAL_STRING(cold, warm);
+
+    ss::Dashboard wide(kTestCfg);
+    wide.cachePretty(4);
+    TEST_ASSERT_TRUE(wide.begin(cache, n));
+    wide.serialize(warm, sizeof(warm), true);
+    TEST_ASSERT_NOT_NULL(strstr(warm, "\r\n    \"title\": \"Test Dashboard\""));
+    TEST_ASSERT_EQUAL(wide.estimatePrettySize() - 1, strlen(warm));
+
+    // Another config or a damaged snapshot is ignored.
+    ss::Dashboard other(kCrcCfg);
+    TEST_ASSERT_TRUE(other.begin(cache, n));
+    TEST_ASSERT_FALSE(other.templatesRestored());
+    TEST_ASSERT_NOT_EQUAL(first.configHash(), other.configHash());
+
+    cache[n - 1] ^= 0x01;
+    ss::Dashboard damaged(kTestCfg);
+    TEST_ASSERT_TRUE(damaged.begin(cache, n));
+    TEST_ASSERT_FALSE(damaged.templatesRestored());
+    damaged.serialize(warm, sizeof(warm));
+    TEST_ASSERT_EQUAL_STRING(ss::StaticProject<kTestCfg>::frame(), warm);
+
+    // Only the layout begin() builds is cached.
+    TEST_ASSERT_EQUAL(1, second.addGroup(kModuleGroup));
+    TEST_ASSERT_EQUAL(0, second.templateCacheSize());
+    TEST_ASSERT_EQUAL(0, second.saveTemplates(cache, sizeof(cache)));
+}
+
+void test_dashboard_lazy_templates(void) {
+    using Project = ss::StaticProject<kTestCfg>;
+    static char buf[4096];
+    static char ref[4096];
+
+    ss::Dashboard dash(kTestCfg);
+    dash.setLazy(true, 5000);
+    dash.cachePretty();
+    TEST_ASSERT_TRUE(dash.begin());
+    TEST_ASSERT_FALSE(dash.templatesResident());
+    TEST_ASSERT_EQUAL(0, dash.footprint().templates);
+    TEST_ASSERT_EQUAL(Project::kMaxFrameSize, dash.maxFrameSize());
+    TEST_ASSERT_EQUAL(Project::kFrameSize + 1, dash.estimateSize());
+    TEST_ASSERT_EQUAL(0, dash.templateCacheSize());
+
+    // Nobody has asked for the project: frames come and go without it.
+    dash.beginFrame(0);
+    TEST_ASSERT_FALSE(dash.templatesResident());
+
+    // The first project frame renders live, the next frame builds templates.
+    TEST_ASSERT_EQUAL(Project::kFrameSize, dash.serialize(buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_STRING(Project::frame(), buf);
+    dash.beginFrame(100);
+    TEST_ASSERT_TRUE(dash.templatesResident());
+    TEST_ASSERT_GREATER_THAN(0, dash.footprint().templates);
+
+    ss::Dashboard eager(kTestCfg);
+    eager.cachePretty();
+    eager.begin();
+    for (ss::Dashboard* d : {&dash, &eager}) {
+        d->setValue(0, 12.5f);
+        d->setText(1, "Run");
+    }
+    for (bool pretty : {false, true}) {
+        eager.serialize(ref, sizeof(ref), pretty);
+        dash.serialize(buf, sizeof(buf), pretty);
+        TEST_ASSERT_EQUAL_STRING(ref, buf);
+    }
+
+    // Served frames keep the templates; an idle stretch releases them.
+    dash.beginFrame(4000);
+    dash.beginFrame(8999);
+    TEST_ASSERT_TRUE(dash.templatesResident());
+    dash.beginFrame(9000);
+    TEST_ASSERT_FALSE(dash.templatesResident());
+    TEST_ASSERT_EQUAL(0, dash.footprint().templates);
+    for (bool pretty : {false, true}) {
+        eager.serialize(ref, sizeof(ref), pretty);
+        TEST_ASSERT_EQUAL(strlen(ref), dash.serialize(buf, sizeof(buf), pretty));
+        TEST_ASSERT_EQUAL_STRING(ref, buf);
+    }
+
+    // Layout changes while released, then an explicit acquire on connect.
+    dash.beginFrame(9100);
+    dash.releaseTemplates();
+    TEST_ASSERT_EQUAL(1, dash.addGroup(kModuleGroup));
+    TEST_ASSERT_EQUAL(1, eager.addGroup(kModuleGroup));
+    TEST_ASSERT_FALSE(dash.templatesResident());
+    TEST_ASSERT_EQUAL(eager.maxFrameSize(), dash.maxFrameSize());
+    TEST_ASSERT_TRUE(dash.acquireTemplates());
+    eager.serialize(ref, sizeof(ref));
+    dash.serialize(buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING(ref, buf);
+}
+
+// ─── Layout images ──────────────────────────────────────────────────────────
+
+struct ImageBuffer {
+    uint8_t data[4096];
+    size_t  len;
+};
+
+static size_t appendImage(void* ctx, const uint8_t* data, size_t len) {
+    auto* buf = static_cast<ImageBuffer*>(ctx);
+    if (buf->len + len > sizeof(buf->data)) return 0;
+    memcpy(buf->data + buf->len, data, len);
+    buf->len += len;
+    return len;
+}
+
+void test_layout_image_round_trip(void) {
+    using Project = ss::StaticProject<kTestCfg>;
+    static char        frame[4096];
+    static ImageBuffer image;
+
+    // A project file compiles to the layout it was generated from.
+    ss::LayoutImage compiled;
+    TEST_ASSERT_FALSE(compiled.loaded());
+    TEST_ASSERT_TRUE(compiled.compile(Project::json(), Project::kJsonSize));
+    TEST_ASSERT_EQUAL(Project::kJsonSize, compiled.sourceSize());
+    {
+        ss::Dashboard dash(compiled.config());
+        TEST_ASSERT_TRUE(dash.begin());
+        dash.serialize(frame, sizeof(frame));
+        TEST_ASSERT_EQUAL_STRING(Project::frame(), frame);
+    }
+
+    // save() reproduces the image load() accepts, pointers and all.
+    image.len = 0;
+    TEST_ASSERT_TRUE(compiled.save(appendImage, &image));
+    TEST_ASSERT_EQUAL(compiled.size(), image.len);
+
+    ss::LayoutImage warm;
+    TEST_ASSERT_TRUE(warm.load(image.data, image.len));
+    TEST_ASSERT_EQUAL(compiled.sourceCrc(), warm.sourceCrc());
+    ss::Dashboard dash(warm.config());
+    TEST_ASSERT_TRUE(dash.begin());
+    dash.serialize(frame, sizeof(frame));
+    TEST_ASSERT_EQUAL_STRING(Project::frame(), frame);
+
+    // Corrupt or truncated images are rejected and the loaded one is kept.
+    image.data[image.len - 2] ^= 0x20;
+    TEST_ASSERT_FALSE(warm.load(image.data, image.len));
+    image.data[image.len - 2] ^= 0x20;
+    TEST_ASSERT_FALSE(warm.load(image.data, image.len - 1));
+    TEST_ASSERT_TRUE(warm.loaded());
+    TEST_ASSERT_EQUAL_STRING("Test Dashboard", warm.config().title);
+    TEST_ASSERT_FALSE(warm.compile("{\"groups\":[", 11));
+}
+
+void test_layout_image_rejects_unknown_names(void) {
+    static const char kEnum[] =
+        "{\"title\":\"N\",\"groups\":[{\"title\":\"G\",\"datasets\":["
+        "{\"title\":\"Mode\",\"telemetryKey\":\"mode\",\"kind\":\"enum\"}]}]}";
+    ss::LayoutImage layout;
+    TEST_ASSERT_TRUE(layout.compile(kEnum, sizeof(kEnum) - 1));
+    TEST_ASSERT_TRUE(layout.config().groups[0].datasets[0].kind == ss::ValueKind::Enum);
+
+    // A misspelt name fails instead of silently becoming the default.
+    static const char kTypo[] =
+        "{\"title\":\"N\",\"groups\":[{\"title\":\"G\",\"datasets\":["
+        "{\"title\":\"Mode\",\"telemetryKey\":\"mode\",\"kind\":\"enumm\"}]}]}";
+    ss::LayoutImage typo;
+    TEST_ASSERT_FALSE(typo.compile(kTypo, sizeof(kTypo) - 1));
+    TEST_ASSERT_FALSE(typo.loaded());
+
+    static const char kAgg[] =
+        "{\"title\":\"N\",\"groups\":[{\"title\":\"G\",\"datasets\":["
+        "{\"title\":\"T\",\"aggregate\":\"median\"}]}]}";
+    TEST_ASSERT_FALSE(typo.compile(kAgg, sizeof(kAgg) - 1));
+}
+
+void test_layout_image_rejects_out_of_range_numbers(void) {
+    // Each of these would be an out-of-range double → integer conversion.
+    static const char* const kBad[] = {
+        "\"index\":300", "\"updateEvery\":-1", "\"valueWidth\":1e9",
+        "\"xAxis\":200", "\"fftSamples\":70000", "\"widgetMax\":1e300",
+    };
+    char json[160];
+    for (const char* field : kBad) {
+        const int n = snprintf(json, sizeof(json),
+                               "{\"title\":\"N\",\"groups\":[{\"title\":\"G\","
+                               "\"datasets\":[{\"title\":\"T\",%s}]}]}", field);
+        ss::LayoutImage layout;
+        TEST_ASSERT_FALSE(layout.compile(json, static_cast<size_t>(n)));
+    }
+
+    // The limits themselves are fine.
+    static const char kEdge[] =
+        "{\"title\":\"N\",\"groups\":[{\"title\":\"G\",\"datasets\":["
+        "{\"title\":\"T\",\"index\":255,\"xAxis\":-128,\"valueWidth\":0}]}]}";
+    ss::LayoutImage edge;
+    TEST_ASSERT_TRUE(edge.compile(kEdge, sizeof(kEdge) - 1));
+    TEST_ASSERT_EQUAL(255, edge.config().groups[0].datasets[0].index);
+    TEST_ASSERT_EQUAL(-128, edge.config().groups[0].datasets[0].xAxis);
+}
+
+void test_layout_image_device_keys(void) {
+    static const char kJson[] =
+        "{\"title\":\"Node\",\"checksum\":\"CRC-16-CCITT\",\"omitDefaults\":true,"
+        "\"groups\":[{\"title\":\"Air\",\"widget\":\"datagrid\",\"datasets\":["
+        "{\"title\":\"T\",\"units\":\"C\",\"widget\":\"gauge\",\"widgetMax\":50,"
+        "\"telemetryKey\":\"air.t\",\"aggregate\":\"max\",\"priority\":\"critical\"},"
+        "{\"title\":\"Mode\",\"telemetryKey\":\"mode\",\"valueWidth\":8,\"kind\":\"string\"}]}]}";
+
+    ss::LayoutImage layout;
+    TEST_ASSERT_TRUE(layout.compile(kJson, sizeof(kJson) - 1));
+
+    const ss::DashboardCfg& cfg = layout.config();
+    TEST_ASSERT_EQUAL(ss::Checksum::Crc16, cfg.checksum);
+    TEST_ASSERT_TRUE(cfg.omitDefaults);
+    TEST_ASSERT_EQUAL(0, cfg.actionCount);
+    TEST_ASSERT_NULL(cfg.actions);
+    TEST_ASSERT_EQUAL(1, cfg.groupCount);
+    TEST_ASSERT_EQUAL(ss::GroupWidget::Datagrid, cfg.groups[0].widget);
+    TEST_ASSERT_EQUAL(2, cfg.groups[0].datasetCount);
+
+    const ss::DatasetCfg& t = cfg.groups[0].datasets[0];
+    TEST_ASSERT_EQUAL(ss::WidgetType::Gauge, t.widget);
+    TEST_ASSERT_EQUAL_FLOAT(50.0f, t.widgetMax);
+    TEST_ASSERT_EQUAL(ss::Aggregate::Max, t.aggregate);
+    TEST_ASSERT_EQUAL(ss::Priority::Critical, t.priority);
+    TEST_ASSERT_EQUAL(256, t.fftSamples);
+    TEST_ASSERT_EQUAL(-1, t.xAxis);
+
+    const ss::DatasetCfg& mode = cfg.groups[0].datasets[1];
+    TEST_ASSERT_EQUAL_STRING("", mode.units);
+    TEST_ASSERT_EQUAL(8, mode.valueWidth);
+    TEST_ASSERT_EQUAL(ss::Priority::Normal, mode.priority);
+    TEST_ASSERT_EQUAL(ss::ValueKind::String, mode.kind);
+    TEST_ASSERT_EQUAL(ss::ValueKind::Auto, t.kind);
+
+    ss::Dashboard dash(cfg);
+    TEST_ASSERT_TRUE(dash.begin());
+    TEST_ASSERT_EQUAL(0, dash.findSlot("air.t"));
+    TEST_ASSERT_EQUAL(1, dash.findSlot("mode"));
+}
+
+// ─── StreamParser ────────────────────────────────────────────────────────────
+
+void test_stream_parser_patches_slots_incrementally(void) {
+    ss::Dashboard dash(kTestCfg);
+    dash.begin();
+    ss::StreamParser parser(dash);
+    char buf[256];
+
+    // Byte-at-a-time feeding: every read may end mid-token.  Unused members,
+    // arrays (even ones holding a matching key) and escapes are all skipped
+    // or decoded on the way.
+    const char doc[] =
+        "{\"temperature\":{\"k\":77.25,\"list\":[1,{\"k\":5}],\"c\":-1.96e2},"
+        " \"skip\":{\"deep\":{\"x\":true,\"y\":null}},"
+        "\"state\":{\"name\":\"Run\\u00e9\"}}\n";
+    size_t docs = 0;
+    for (size_t i = 0; i + 1 < sizeof(doc); ++i) docs += parser.feed(doc + i, 1);
+    TEST_ASSERT_EQUAL(1, docs);
+    dash.serializeData(buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("/*77.25,Run\xC3\xA9*/\r\n", buf);
+
+    // Anything after a document's closing brace other than whitespace is
+    // dropped up to the newline; the next line parses normally.
+    const char lines[] =
+        "{\"temperature\":{\"k\":1}},\"state\":{\"name\":\"Lost\"}}\n"
+        "{\"temperature\":{\"k\":2},\"state\":{\"name\":\"Idle\"}}\r\n";
+    TEST_ASSERT_EQUAL(2, parser.feed(lines, strlen(lines)));
+    TEST_ASSERT_EQUAL(1, parser.errors());
+    TEST_ASSERT_EQUAL(3, parser.documents());
+    dash.serializeData(buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("/*2,Idle*/\r\n", buf);
+
+    // A document cut off by reset() applies nothing more.
+    const char cut[] = "{\"temperature\":{\"k\":3";
+    parser.feed(cut, strlen(cut));
+    parser.reset();
+    parser.feed("9}}\n", 4);
+    TEST_ASSERT_EQUAL(2, parser.errors());
+    dash.serializeData(buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("/*2,Idle*/\r\n", buf);
+
+    // Numbers follow the JSON grammar whether or not a slot listens, so a
+    // bad one in an unmatched member still counts; valid ones never do.
+    static const char* const kBad[] = {
+        "1.2.3", "01", "-", "1.", ".5", "1e", "1e+", "2-1", "1E5e2", "-x",
+    };
+    for (const char* n : kBad) {
+        char line[64];
+        const int len = snprintf(line, sizeof(line), "{\"other\":%s}\n", n);
+        const uint32_t before = parser.errors();
+        TEST_ASSERT_EQUAL(0, parser.feed(line, static_cast<size_t>(len)));
+        TEST_ASSERT_EQUAL(before + 1, parser.errors());
+    }
+    static const char kGood[] =
+        "{\"other\":[0,-0,0.5,-12.25e-3,1E+2,7e0],\"temperature\":{\"k\":-0.5e1}}\n";
+    const uint32_t errors = parser.errors();
+    TEST_ASSERT_EQUAL(1, parser.feed(kGood, sizeof(kGood) - 1));
+    TEST_ASSERT_EQUAL(errors, parser.errors());
+    dash.serializeData(buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("/*-5,Idle*/\r\n", buf);
+}
+
+// ─── Checksums ──────────────────────────────────────────────────────────────
+
+static uint32_t crcOf(ss::Checksum algo, const char* s) {
+    ss::FrameCrc crc(algo);
+    crc.update(s, strlen(s));
+    return crc.value();
+}
+
+void test_checksum_check_values(void) {
+    // Standard "123456789" check values for each algorithm.
+    TEST_ASSERT_EQUAL_HEX32(0xF4,       crcOf(ss::Checksum::Crc8,  "123456789"));
+    TEST_ASSERT_EQUAL_HEX32(0x29B1,     crcOf(ss::Checksum::Crc16, "123456789"));
+
+    // Serial Studio's own check value for each name it is advertised under:
+    // 0x29B1 is CRC-16-CCITT; its "CRC-16" (0xBB3D) is another algorithm.
+    TEST_ASSERT_EQUAL_STRING("CRC-16-CCITT", ss::checksumName(ss::Checksum::Crc16));
+    static const char kPlain[] = "{\"title\":\"T\",\"checksum\":\"CRC-16\",\"groups\":[]}";
+    ss::LayoutImage plain;
+    TEST_ASSERT_TRUE(plain.compile(kPlain, sizeof(kPlain) - 1));
+    TEST_ASSERT_EQUAL(ss::Checksum::None, plain.config().checksum);
+    TEST_ASSERT_EQUAL_HEX32(0xCBF43926, crcOf(ss::Checksum::Crc32, "123456789"));
+
+    // Feeding the same bytes in pieces gives the same result.
+    ss::FrameCrc crc(ss::Checksum::Crc32);
+    crc.update("1234", 4);
+    crc.update("56789", 5);
+    TEST_ASSERT_EQUAL_HEX32(0xCBF43926, crc.value());
+
+    char out[4];
+    TEST_ASSERT_EQUAL(4, crc.write(out));
+    TEST_ASSERT_EQUAL_HEX8(0xCB, static_cast<uint8_t>(out[0]));
+    TEST_ASSERT_EQUAL_HEX8(0x26, static_cast<uint8_t>(out[3]));
+}
+
+void test_dashboard_frames_carry_checksum(void) {
+    ss::Dashboard dash(kCrcCfg);
+    dash.begin();
+
+    JsonDocument telemetry;
+    telemetry["temperature"]["k"] = 78.45f;
+    telemetry["state"]["name"]    = "Operating";
+    dash.update(telemetry);
+
+    // Data row: payload, "*/", two CRC-16 bytes (big-endian), CRLF.
+    char buf[256];
+    size_t len = dash.serializeData(buf, sizeof(buf));
+    const char payload[] = "78.45,Operating";
+    const uint32_t sum   = crcOf(ss::Checksum::Crc16, payload);
+    TEST_ASSERT_EQUAL(2 + strlen(payload) + 2 + 2 + 2, len);
+    TEST_ASSERT_EQUAL(0, memcmp(buf + 2, payload, strlen(payload)));
+    TEST_ASSERT_EQUAL_HEX8(sum >> 8,   static_cast<uint8_t>(buf[len - 4]));
+    TEST_ASSERT_EQUAL_HEX8(sum & 0xFF, static_cast<uint8_t>(buf[len - 3]));
+
+    // Project frame advertises the algorithm and carries its own checksum.
+    char big[4096];
+    len = dash.serialize(big, sizeof(big));
+    TEST_ASSERT_GREATER_THAN(0, len);
+    JsonDocument doc;
+    TEST_ASSERT_TRUE(deserializeJson(doc, big + 2, len - 8) == DeserializationError::Ok);
+    TEST_ASSERT_EQUAL_STRING("CRC-16-CCITT", doc["checksum"].as<const char*>());
+
+    ss::FrameCrc crc(ss::Checksum::Crc16);
+    crc.update(big + 2, len - 8);
+    TEST_ASSERT_EQUAL_HEX8(crc.value() >> 8, static_cast<uint8_t>(big[len - 4]));
+    TEST_ASSERT_EQUAL('/', big[len - 5]);
+
+    // The checksum is folded in while the frame is written, on the live
+    // pretty render and the cached splice alike; both match a second pass
+    // over the payload ("\n" before "*/" included).
+    for (int cached = 0; cached < 2; ++cached) {
+        if (cached) TEST_ASSERT_TRUE(dash.cachePretty());
+        len = dash.serialize(big, sizeof(big), true);
+        TEST_ASSERT_GREATER_THAN(0, len);
+        ss::FrameCrc pretty(ss::Checksum::Crc16);
+        pretty.update(big + 2, len - 10);
+        TEST_ASSERT_EQUAL_HEX8(pretty.value() >> 8,   static_cast<uint8_t>(big[len - 6]));
+        TEST_ASSERT_EQUAL_HEX8(pretty.value() & 0xFF, static_cast<uint8_t>(big[len - 5]));
+    }
+}
+
+// ─── FrameCoalescer ─────────────────────────────────────────────────────────
+
+struct SinkCapture {
+    char   data[4096];
+    size_t len    = 0;
+    int    calls  = 0;
+    size_t budget = SIZE_MAX;   ///< Bytes the link takes before it backs up
+};
+
+static size_t captureSink(void* ctx, const char* data, size_t len) {
+    auto* cap = static_cast<SinkCapture*>(ctx);
+    if (len > cap->budget) len = cap->budget;
+    cap->budget -= len;
+    memcpy(cap->data + cap->len, data, len);
+    cap->len += len;
+    ++cap->calls;
+    return len;
+}
+
+void test_coalescer_batches_until_mtu(void) {
+    SinkCapture cap;
+    ss::CoalescerCfg cfg;
+    cfg.mtu             = 64;
+    cfg.flushDeadlineMs = 1000;
+    ss::FrameCoalescer co(cfg, &captureSink, &cap);
+
+    const char frame[] = "/*1,2,3*/\r\n";           // 11 bytes
+    for (int i = 0; i < 5; ++i) {
+        TEST_ASSERT_TRUE(co.push(frame, sizeof(frame) - 1, 0));
+    }
+    TEST_ASSERT_EQUAL(0, cap.calls);                  // 55 bytes still pending
+
+    TEST_ASSERT_TRUE(co.push(frame, sizeof(frame) - 1, 0));
+    TEST_ASSERT_EQUAL(1, cap.calls);                  // 6th frame closed the segment
+    TEST_ASSERT_EQUAL(55, cap.len);
+    TEST_ASSERT_EQUAL(11, co.pending());
+}
+
+void test_coalescer_flushes_on_deadline(void) {
+    SinkCapture cap;
+    ss::CoalescerCfg cfg;
+    cfg.flushDeadlineMs = 5;
+    ss::FrameCoalescer co(cfg, &captureSink, &cap);
+
+    co.push("/*1*/\r\n", 7, 100);
+    TEST_ASSERT_FALSE(co.poll(104));
+    TEST_ASSERT_EQUAL(0, cap.calls);
+    TEST_ASSERT_TRUE(co.poll(105));
+    TEST_ASSERT_EQUAL(1, cap.calls);
+    TEST_ASSERT_EQUAL(0, co.pending());
+}
+
+void test_coalescer_streams_oversized_frames(void) {
+    SinkCapture cap;
+    ss::CoalescerCfg cfg;
+    cfg.mtu = 16;
+    ss::FrameCoalescer co(cfg, &captureSink, &cap);
+
+    co.push("/*1*/\r\n", 7, 0);
+    char big[40];
+    memset(big, 'x', sizeof(big));
+    TEST_ASSERT_EQUAL(sizeof(big), co.push(big, sizeof(big), 0));
+
+    // The large frame follows the pending bytes in MTU-sized segments; the
+    // last piece waits for its deadline like any small frame.
+    TEST_ASSERT_EQUAL(2, cap.calls);
+    TEST_ASSERT_EQUAL(32, cap.len);
+    TEST_ASSERT_EQUAL(15, co.pending());
+    TEST_ASSERT_TRUE(co.flush());
+    TEST_ASSERT_EQUAL(47, cap.len);
+    TEST_ASSERT_EQUAL_CHAR('x', cap.data[7]);
+    TEST_ASSERT_EQUAL_CHAR('x', cap.data[46]);
+}
+
+void test_coalescer_keeps_bytes_a_backed_up_link_refused(void) {
+    SinkCapture cap;
+    cap.budget = 20;
+    ss::CoalescerCfg cfg;
+    cfg.mtu = 16;
+    ss::FrameCoalescer co(cfg, &captureSink, &cap);
+
+    char big[40];
+    for (size_t i = 0; i < sizeof(big); ++i) big[i] = static_cast<char>('A' + i);
+
+    // The link takes 20 bytes and stalls: part of the frame is accepted
+    // and the caller keeps the rest.
+    const size_t taken = co.push(big, sizeof(big), 0);
+    TEST_ASSERT_LESS_THAN(sizeof(big), taken);
+    TEST_ASSERT_EQUAL(20, cap.len);
+
+    // A small frame is refused whole while the segment cannot drain.
+    TEST_ASSERT_EQUAL(0, co.push("/*1*/\r\n", 7, 0));
+
+    // Once the link recovers, retrying the remainder gives the exact stream.
+    cap.budget = SIZE_MAX;
+    size_t sent = taken;
+    while (sent < sizeof(big)) sent += co.push(big + sent, sizeof(big) - sent, 0);
+    TEST_ASSERT_TRUE(co.flush());
+    TEST_ASSERT_EQUAL(sizeof(big), cap.len);
+    TEST_ASSERT_EQUAL_MEMORY(big, cap.data, sizeof(big));
+    TEST_ASSERT_EQUAL(1, co.framesIn());
+
+    // A link that closes with a partial frame queued: reset() drops the
+    // tail so the next link starts on a frame boundary.
+    cap.len = 0;
+    co.push(big, sizeof(big), 0);
+    TEST_ASSERT_GREATER_THAN(0, co.pending());
+    co.reset();
+    TEST_ASSERT_EQUAL(0, co.pending());
+    co.push("/*1*/\r\n", 7, 0);
+    TEST_ASSERT_TRUE(co.flush());
+    TEST_ASSERT_EQUAL_MEMORY(big, cap.data, 32);
+    TEST_ASSERT_EQUAL_MEMORY("/*1*/\r\n", cap.data + 32, 7);
+}
+
+// ─── RateController ─────────────────────────────────────────────────────────
+
+void test_rate_controller_tracks_link_throughput(void) {
+    ss::RateControllerCfg cfg;
+    cfg.targetUtilPct = 50;
+    cfg.smoothingPct  = 100;    // no smoothing — makes the steps exact
+    ss::RateController rc(cfg, 1000);
+    TEST_ASSERT_EQUAL(1000, rc.intervalMs());
+
+    // 115200 baud ≈ 11.5 KB/s: a 2 KB frame takes ~174 ms → 348 ms at 50 %.
+    rc.recordFrame(2000, 173611);
+    TEST_ASSERT_EQUAL(11520, rc.throughputBps());
+    TEST_ASSERT_EQUAL(347, rc.intervalMs());
+    TEST_ASSERT_EQUAL(50, rc.utilisationPct());
+
+    // A fast link drives the interval down to the configured floor.
+    rc.recordFrame(2000, 500);
+    TEST_ASSERT_EQUAL(cfg.minIntervalMs, rc.intervalMs());
+
+    TEST_ASSERT_TRUE(rc.due(100));
+    TEST_ASSERT_FALSE(rc.due(105));
+    TEST_ASSERT_TRUE(rc.due(110));
+}
+
+void test_rate_controller_smooths_measurements(void) {
+    ss::RateControllerCfg cfg;
+    cfg.targetUtilPct = 100;
+    cfg.smoothingPct  = 50;
+    ss::RateController rc(cfg, 1000);
+
+    rc.recordFrame(1000, 100000);     // 100 ms
+    rc.recordFrame(1000, 300000);     // 300 ms → EWMA 200 ms
+    TEST_ASSERT_EQUAL(200000, rc.drainUs());
+    TEST_ASSERT_EQUAL(200, rc.intervalMs());
+}
+
+void test_rate_controller_estimates_coalesced_frames(void) {
+    ss::RateControllerCfg cfg;
+    cfg.targetUtilPct = 50;
+    cfg.smoothingPct  = 100;
+    ss::RateController rc(cfg, 1000);
+
+    // Nothing measured yet: a frame alone cannot move the interval.
+    rc.recordFrame(2000);
+    TEST_ASSERT_EQUAL(1000, rc.intervalMs());
+
+    // Timed segment writes set the throughput but leave the interval alone.
+    rc.recordWrite(1460, 126736);     // 11520 B/s
+    TEST_ASSERT_EQUAL(11520, rc.throughputBps());
+    TEST_ASSERT_EQUAL(1000, rc.intervalMs());
+
+    // A 2 KB frame at that rate drains in ~174 ms → 347 ms at 50 %.
+    rc.recordFrame(2000);
+    TEST_ASSERT_EQUAL(347, rc.intervalMs());
+    TEST_ASSERT_EQUAL(50, rc.utilisationPct());
+}
+
+// ─── ProjectHandshake ───────────────────────────────────────────────────────
+
+void test_dashboard_layout_hash(void) {
+    ss::Dashboard a(kTestCfg);
+    ss::Dashboard b(kTestCfg);
+    ss::Dashboard c(kPluggedCfg);
+    a.begin();
+    b.setLazy(true);
+    b.begin();
+    c.begin();
+    const uint32_t base = a.layoutHash();
+
+    // Equal layouts hash equal, whatever the values or template residency.
+    TEST_ASSERT_EQUAL_HEX32(base, b.layoutHash());
+    a.setValue(0, 42.0f);
+    TEST_ASSERT_EQUAL_HEX32(base, a.layoutHash());
+    TEST_ASSERT_NOT_EQUAL(base, c.layoutHash());
+
+    // Layout changes move it; undoing them brings it back.
+    TEST_ASSERT_EQUAL(1, a.addGroup(kModuleGroup));
+    TEST_ASSERT_EQUAL_HEX32(c.layoutHash(), a.layoutHash());
+    a.setGroupEnabled(1, false);
+    TEST_ASSERT_EQUAL_HEX32(base, a.layoutHash());
+    a.setDatasetEnabled(0, false);
+    TEST_ASSERT_NOT_EQUAL(base, a.layoutHash());
+    a.setDatasetEnabled(0, true);
+    TEST_ASSERT_EQUAL_HEX32(base, a.layoutHash());
+}
+
+void test_handshake_skips_known_projects(void) {
+    ss::HandshakeCfg cfg;
+    cfg.rememberMs = 60000;
+    ss::ProjectHandshake hs(cfg);
+
+    // First contact, then a reconnect to the same layout.
+    TEST_ASSERT_TRUE(hs.needsProject(0x0A000002, 0x1234, 0));
+    hs.projectSent(0x0A000002, 0x1234, 0);
+    TEST_ASSERT_FALSE(hs.needsProject(0x0A000002, 0x1234, 500));
+    TEST_ASSERT_TRUE(hs.needsProject(0x0A000003, 0x1234, 500));
+
+    // A new layout, an expired entry and a forgotten client all resend.
+    TEST_ASSERT_TRUE(hs.needsProject(0x0A000002, 0x5678, 500));
+    TEST_ASSERT_TRUE(hs.needsProject(0x0A000002, 0x1234, 60000));
+    hs.forget(0x0A000002);
+    TEST_ASSERT_TRUE(hs.needsProject(0x0A000002, 0x1234, 500));
+
+    // A full table evicts the client served longest ago.
+    for (uint32_t i = 0; i < ss::ProjectHandshake::kMaxClients; ++i) {
+        hs.projectSent(100 + i, 0x1234, 1000 + i);
+    }
+    hs.projectSent(999, 0x1234, 2000);
+    TEST_ASSERT_TRUE(hs.needsProject(100, 0x1234, 2000));
+    TEST_ASSERT_FALSE(hs.needsProject(101, 0x1234, 2000));
+    TEST_ASSERT_FALSE(hs.needsProject(999, 0x1234, 2000));
+}
+
 // ─── Test runner ─────────────────────────────────────────────────────────────
 
 void run_dashboard_tests() {
@@ -289,4 +2024,46 @@ void run_dashboard_tests() {
     RUN_TEST(test_dashboard_serialize_pretty_has_delimiters);
     RUN_TEST(test_dashboard_serialize_pretty_is_larger);
     RUN_TEST(test_dashboard_serialize_pretty_is_valid_json);
+    RUN_TEST(test_dashboard_serialize_data_row);
+    RUN_TEST(test_dashboard_ingest_filters_raw_telemetry);
+    RUN_TEST(test_dashboard_pooled_telemetry);
+    RUN_TEST(test_dashboard_fft_ring_drains_as_burst);
+    RUN_TEST(test_dashboard_fft_burst_keeps_unsent_samples);
+    RUN_TEST(test_dashboard_batch_emits_one_row_per_timestamp);
+    RUN_TEST(test_dashboard_batch_keeps_rows_that_do_not_fit);
+    RUN_TEST(test_dashboard_aggregates_between_frames);
+    RUN_TEST(test_dashboard_alarm_edges_with_hysteresis);
+    RUN_TEST(test_dashboard_alarms_see_ring_and_batch_samples);
+    RUN_TEST(test_dashboard_scheduler_rates_and_round_robin);
+    RUN_TEST(test_dashboard_scheduler_keeps_windows_and_alarms);
+    RUN_TEST(test_dashboard_packed_decoder_rows);
+    RUN_TEST(test_static_project_matches_runtime);
+    RUN_TEST(test_project_writer_formats_numbers);
+    RUN_TEST(test_dashboard_frame_size_bounds);
+    RUN_TEST(test_dashboard_typed_setters_and_footprint);
+    RUN_TEST(test_dashboard_struct_fields);
+    RUN_TEST(test_dashboard_struct_field_only);
+    RUN_TEST(test_dashboard_value_kinds);
+    RUN_TEST(test_dashboard_enum_labels);
+    RUN_TEST(test_project_omits_defaults);
+    RUN_TEST(test_dashboard_cached_pretty_template);
+    RUN_TEST(test_dashboard_runtime_layout);
+    RUN_TEST(test_dashboard_template_cache);
+    RUN_TEST(test_dashboard_lazy_templates);
+    RUN_TEST(test_layout_image_round_trip);
+    RUN_TEST(test_layout_image_device_keys);
+    RUN_TEST(test_layout_image_rejects_unknown_names);
+    RUN_TEST(test_layout_image_rejects_out_of_range_numbers);
+    RUN_TEST(test_stream_parser_patches_slots_incrementally);
+    RUN_TEST(test_checksum_check_values);
+    RUN_TEST(test_dashboard_frames_carry_checksum);
+    RUN_TEST(test_coalescer_batches_until_mtu);
+    RUN_TEST(test_coalescer_flushes_on_deadline);
+    RUN_TEST(test_coalescer_streams_oversized_frames);
+    RUN_TEST(test_coalescer_keeps_bytes_a_backed_up_link_refused);
+    RUN_TEST(test_rate_controller_tracks_link_throughput);
+    RUN_TEST(test_rate_controller_smooths_measurements);
+    RUN_TEST(test_rate_controller_estimates_coalesced_frames);
+    RUN_TEST(test_dashboard_layout_hash);
+    RUN_TEST(test_handshake_skips_known_projects);
 }